@@ -0,0 +1,176 @@
+//
+//  SignalBenchmarks.cpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#include "SignalBenchmarks.hpp"
+#include "Utilities.hpp"
+#include "Signal.hpp"
+#include "Delegate.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr const std::size_t TotalEmits { 1000000 };
+constexpr const std::size_t ListenerCount { 4 };
+constexpr const std::size_t FanInEmits { 200000 };
+constexpr const std::size_t FanInListeners { 5 };
+constexpr const std::size_t CallbackCalls { 10000000 };
+constexpr const std::size_t ChurnSubscribers { 10000 };
+
+/// @brief executor that calls listeners directly on the emitting thread
+class InlineExecutor : public gusc::Threads::Executor
+{
+public:
+    bool isCurrent() const noexcept override
+    {
+        return true;
+    }
+    void post(gusc::Threads::Message&& message) override
+    {
+        message();
+    }
+};
+
+thread_local int sink { 0 };
+}
+
+void benchmarkEmitters(std::size_t emitterCount)
+{
+    const std::size_t emitsPerEmitter = TotalEmits / emitterCount;
+    const std::size_t total = emitsPerEmitter * emitterCount;
+
+    InlineExecutor executor;
+    gusc::Threads::Signal<int> signal;
+    for (std::size_t l = 0; l < ListenerCount; ++l)
+    {
+        signal.connect(&executor, [](const int& value){
+            sink += value;
+        });
+    }
+    std::atomic<bool> isGo { false };
+
+    std::vector<std::thread> emitters;
+    for (std::size_t e = 0; e < emitterCount; ++e)
+    {
+        emitters.emplace_back([&](){
+            waitFor(isGo);
+            for (std::size_t i = 0; i < emitsPerEmitter; ++i)
+            {
+                signal.emit(static_cast<int>(i));
+            }
+        });
+    }
+
+    const auto start = BenchmarkClock::now();
+    isGo.store(true, std::memory_order_release);
+    for (auto& emitter : emitters)
+    {
+        emitter.join();
+    }
+    const auto elapsed = BenchmarkClock::now() - start;
+    report("Signal::emit " + std::to_string(emitterCount) + " emitter(s), " + std::to_string(ListenerCount) + " direct listeners", total, elapsed);
+}
+
+/// @brief all the listeners on a single worker thread
+/// @param isCoalesced - connect all the listeners to one signal (one message per emit) or each to it's own signal (one message per listener, same queue traffic as without coalescing)
+void benchmarkFanIn(bool isCoalesced)
+{
+    const std::size_t total = FanInEmits * FanInListeners;
+    gusc::Threads::Thread worker;
+    std::vector<std::unique_ptr<gusc::Threads::Signal<int>>> signals(isCoalesced ? 1 : FanInListeners);
+    for (auto& signal : signals)
+    {
+        signal = std::make_unique<gusc::Threads::Signal<int>>();
+    }
+    std::size_t received { 0 };
+    std::atomic<bool> isDone { false };
+    for (std::size_t l = 0; l < FanInListeners; ++l)
+    {
+        signals[l % signals.size()]->connect(&worker, [&](const int&){
+            if (++received == total)
+            {
+                isDone.store(true, std::memory_order_release);
+            }
+        });
+    }
+    worker.start();
+
+    const auto start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < FanInEmits; ++i)
+    {
+        for (auto& signal : signals)
+        {
+            signal->emit(static_cast<int>(i));
+        }
+    }
+    waitFor(isDone);
+    const auto elapsed = BenchmarkClock::now() - start;
+    report(std::string("Signal::emit ") + std::to_string(FanInListeners) + " listeners on one thread, " + (isCoalesced ? "coalesced" : "message per listener"), total, elapsed);
+}
+
+/// @brief cost of calling a type-erased listener directly and of copying it into a queued call (like signals did before delegates)
+template<typename TCallback>
+void benchmarkCallback(const std::string& name)
+{
+    int a { 0 };
+    int b { 0 };
+    // Three pointers - too big for std::function's inline storage
+    const TCallback callback = [pa = &a, pb = &b, ps = &sink](const int& value){
+        *ps += value + *pa + *pb;
+    };
+
+    auto start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < CallbackCalls; ++i)
+    {
+        callback(static_cast<int>(i));
+    }
+    report(name + " direct call", CallbackCalls, BenchmarkClock::now() - start);
+
+    start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < CallbackCalls; ++i)
+    {
+        const TCallback queued(callback);
+        queued(static_cast<int>(i));
+    }
+    report(name + " queued call (copy and call)", CallbackCalls, BenchmarkClock::now() - start);
+}
+
+/// @brief transient subscribers connecting and disconnecting while a large number of others stay connected
+void benchmarkChurn()
+{
+    InlineExecutor executor;
+    gusc::Threads::Signal<int> signal;
+    const auto listener = [](const int& value){
+        sink += value;
+    };
+    for (std::size_t i = 0; i < ChurnSubscribers; ++i)
+    {
+        signal.connect(&executor, listener);
+    }
+    const auto start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < ChurnSubscribers; ++i)
+    {
+        signal.disconnect(signal.connect(&executor, listener));
+    }
+    report("Signal::connect + disconnect with " + std::to_string(ChurnSubscribers) + " subscribers", ChurnSubscribers, BenchmarkClock::now() - start);
+}
+
+void runSignalBenchmarks()
+{
+    benchmarkCallback<std::function<void(const int&)>>("std::function");
+    benchmarkCallback<gusc::Threads::Delegate<void(const int&)>>("Delegate");
+
+    for (std::size_t emitterCount = 1; emitterCount <= 8; emitterCount *= 2)
+    {
+        benchmarkEmitters(emitterCount);
+    }
+    benchmarkFanIn(false);
+    benchmarkFanIn(true);
+    benchmarkChurn();
+}
@@ -0,0 +1,13 @@
+//
+//  SignalBenchmarks.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef SignalBenchmarks_hpp
+#define SignalBenchmarks_hpp
+
+void runSignalBenchmarks();
+
+#endif /* SignalBenchmarks_hpp */
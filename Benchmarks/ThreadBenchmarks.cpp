@@ -0,0 +1,166 @@
+//
+//  ThreadBenchmarks.cpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#include "ThreadBenchmarks.hpp"
+#include "Utilities.hpp"
+#include "Thread.hpp"
+
+#include <algorithm>
+#include <future>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr const std::size_t TotalMessages { 1000000 };
+}
+
+void benchmarkProducers(std::size_t producerCount)
+{
+    const std::size_t messagesPerProducer = TotalMessages / producerCount;
+    const std::size_t total = messagesPerProducer * producerCount;
+
+    gusc::Threads::Thread consumer;
+    std::size_t received { 0 };
+    std::atomic<bool> isDone { false };
+    std::atomic<bool> isGo { false };
+    consumer.start();
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&](){
+            waitFor(isGo);
+            for (std::size_t i = 0; i < messagesPerProducer; ++i)
+            {
+                consumer.send([&](){
+                    if (++received == total)
+                    {
+                        isDone.store(true, std::memory_order_release);
+                    }
+                });
+            }
+        });
+    }
+
+    const auto start = BenchmarkClock::now();
+    isGo.store(true, std::memory_order_release);
+    waitFor(isDone);
+    const auto elapsed = BenchmarkClock::now() - start;
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    report("Thread::send " + std::to_string(producerCount) + " producer(s)", total, elapsed);
+}
+
+void benchmarkBatches(std::size_t batchSize)
+{
+    const std::size_t batchCount = TotalMessages / batchSize;
+    const std::size_t total = batchCount * batchSize;
+
+    gusc::Threads::Thread consumer;
+    std::size_t received { 0 };
+    std::atomic<bool> isDone { false };
+    const auto message = [&](){
+        if (++received == total)
+        {
+            isDone.store(true, std::memory_order_release);
+        }
+    };
+    const std::vector<std::decay_t<decltype(message)>> batch(batchSize, message);
+    consumer.start();
+
+    const auto start = BenchmarkClock::now();
+    for (std::size_t b = 0; b < batchCount; ++b)
+    {
+        consumer.sendBatch(batch.begin(), batch.end());
+    }
+    waitFor(isDone);
+    const auto elapsed = BenchmarkClock::now() - start;
+    report("Thread::sendBatch batch size " + std::to_string(batchSize), total, elapsed);
+}
+
+void benchmarkTimers(std::size_t timerCount)
+{
+    gusc::Threads::Thread consumer(gusc::Threads::IdleStrategy::Park);
+    std::size_t received { 0 };
+    BenchmarkClock::duration maxLateness { 0 };
+    std::atomic<bool> isDone { false };
+    std::mt19937 random(42);
+    consumer.start();
+
+    // Deadlines spread over the next second
+    const auto start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < timerCount; ++i)
+    {
+        const auto deadline = start + std::chrono::microseconds(random() % 1000000);
+        consumer.sendAt(deadline, [&, deadline](){
+            maxLateness = std::max(maxLateness, BenchmarkClock::now() - deadline);
+            if (++received == timerCount)
+            {
+                isDone.store(true, std::memory_order_release);
+            }
+        });
+    }
+    const auto elapsed = BenchmarkClock::now() - start;
+    waitFor(isDone);
+    report("Thread::sendAt " + std::to_string(timerCount) + " pending timers", timerCount, elapsed);
+    std::cout << "Thread::sendAt " << timerCount << " pending timers max lateness: "
+              << std::chrono::duration<double, std::micro>(maxLateness).count() << " us" << std::endl;
+}
+
+void benchmarkInvoke()
+{
+    constexpr std::size_t roundTrips { 100000 };
+    gusc::Threads::Thread worker;
+    worker.start();
+    std::size_t sum { 0 };
+
+    auto start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < roundTrips; ++i)
+    {
+        std::promise<std::size_t> promise;
+        auto future = promise.get_future();
+        worker.send([&promise, i](){
+            promise.set_value(i);
+        });
+        sum += future.get();
+    }
+    report("std::promise round trip", roundTrips, BenchmarkClock::now() - start);
+
+    start = BenchmarkClock::now();
+    for (std::size_t i = 0; i < roundTrips; ++i)
+    {
+        sum += worker.invoke([i](){
+            return i;
+        }).get();
+    }
+    report("Thread::invoke round trip", roundTrips, BenchmarkClock::now() - start);
+    if (sum == 0)
+    {
+        std::cout << "Unexpected sum" << std::endl;
+    }
+}
+
+void runThreadBenchmarks()
+{
+    for (std::size_t producerCount = 1; producerCount <= 32; producerCount *= 2)
+    {
+        benchmarkProducers(producerCount);
+    }
+    for (std::size_t batchSize = 1; batchSize <= 256; batchSize *= 16)
+    {
+        benchmarkBatches(batchSize);
+    }
+    for (std::size_t timerCount = 1000; timerCount <= 100000; timerCount *= 10)
+    {
+        benchmarkTimers(timerCount);
+    }
+    benchmarkInvoke();
+}
@@ -0,0 +1,13 @@
+//
+//  ThreadBenchmarks.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef ThreadBenchmarks_hpp
+#define ThreadBenchmarks_hpp
+
+void runThreadBenchmarks();
+
+#endif /* ThreadBenchmarks_hpp */
@@ -0,0 +1,38 @@
+//
+//  Utilities.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef Utilities_h
+#define Utilities_h
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+/// @brief wait until the flag is raised by another thread
+inline void waitFor(const std::atomic<bool>& flag) noexcept
+{
+    while (!flag.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+/// @brief print a single benchmark result row
+inline void report(const std::string& name, std::size_t operations, BenchmarkClock::duration elapsed)
+{
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    const auto nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(operations);
+    std::cout << name << ": "
+              << static_cast<std::size_t>(static_cast<double>(operations) / seconds) << " ops/s, "
+              << nsPerOp << " ns/op" << std::endl;
+}
+
+#endif /* Utilities_h */
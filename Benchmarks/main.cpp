@@ -0,0 +1,15 @@
+//
+//  main.cpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#include "ThreadBenchmarks.hpp"
+#include "SignalBenchmarks.hpp"
+
+int main(int argc, const char * argv[]) {
+    runThreadBenchmarks();
+    runSignalBenchmarks();
+    return 0;
+}
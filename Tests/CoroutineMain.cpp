@@ -0,0 +1,14 @@
+//
+//  CoroutineMain.cpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#include "CoroutineTests.hpp"
+#include "Utilities.hpp"
+
+int main(int argc, const char * argv[]) {
+    runCoroutineTests();
+    return failedExpectations() ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+//
+//  CoroutineTests.cpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#include "CoroutineTests.hpp"
+#include "Utilities.hpp"
+#include "Coroutines.hpp"
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+static Logger clog;
+}
+
+class ManualExecutor : public gusc::Threads::Executor
+{
+public:
+    explicit ManualExecutor(bool initIsCurrent = false)
+        : isCurrentThread(initIsCurrent)
+    {}
+    bool isCurrent() const noexcept override
+    {
+        return isCurrentThread;
+    }
+    void post(gusc::Threads::Message&& message) override
+    {
+        messages.emplace_back(std::move(message));
+    }
+    void run()
+    {
+        auto pending = std::move(messages);
+        messages.clear();
+        for (auto& message : pending)
+        {
+            message();
+        }
+    }
+    std::vector<gusc::Threads::Message> messages;
+    const bool isCurrentThread { false };
+};
+
+gusc::Threads::Task hop(gusc::Threads::Thread& io, gusc::Threads::Thread& compute, std::vector<std::thread::id>& path, std::promise<void>& done)
+{
+    co_await gusc::Threads::schedule(io);
+    path.push_back(std::this_thread::get_id());
+    co_await gusc::Threads::schedule(compute);
+    path.push_back(std::this_thread::get_id());
+    co_await gusc::Threads::schedule(io);
+    path.push_back(std::this_thread::get_id());
+    done.set_value();
+}
+
+void testSchedule()
+{
+    gusc::Threads::Thread io;
+    gusc::Threads::Thread compute;
+    io.start();
+    compute.start();
+
+    const auto ioId = io.invoke([](){ return std::this_thread::get_id(); }).get();
+    const auto computeId = compute.invoke([](){ return std::this_thread::get_id(); }).get();
+    std::vector<std::thread::id> path;
+    std::promise<void> done;
+    hop(io, compute, path, done);
+    expect(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, "coroutine finishes after hopping between threads");
+    expect(path == std::vector<std::thread::id>({ ioId, computeId, ioId }), "coroutine resumes on the scheduled threads");
+
+    // Scheduling on the current executor does not suspend
+    ManualExecutor current(true);
+    bool isFinished { false };
+    [](ManualExecutor& executor, bool& finished) -> gusc::Threads::Task {
+        co_await gusc::Threads::schedule(executor);
+        finished = true;
+    }(current, isFinished);
+    expect(isFinished && current.messages.empty(), "scheduling on the current executor continues inline");
+
+    io.stop();
+    compute.stop();
+    io.join();
+    compute.join();
+    clog << "Coroutine hops: " + std::to_string(path.size());
+}
+
+void testNextEmission()
+{
+    ManualExecutor executor;
+    gusc::Threads::Signal<int> sigInt;
+    std::vector<int> values;
+    [](gusc::Threads::Signal<int>& sig, ManualExecutor& target, std::vector<int>& received) -> gusc::Threads::Task {
+        for (int i = 0; i < 2; ++i)
+        {
+            received.push_back(co_await gusc::Threads::next(sig, target));
+        }
+    }(sigInt, executor, values);
+
+    sigInt.emit(1);
+    expect(values.empty(), "awaiting coroutine is resumed on it's executor");
+    executor.run();
+    expect(values == std::vector<int>({ 1 }), "coroutine receives the emitted value");
+    sigInt.emit(2);
+    sigInt.emit(3);
+    executor.run();
+    expect(values == std::vector<int>({ 1, 2 }), "coroutine receives only the next emission");
+    sigInt.emit(4);
+    executor.run();
+    expect(values == std::vector<int>({ 1, 2 }), "one-shot connection is removed after resuming");
+
+    gusc::Threads::Signal<int, std::string> sigPair;
+    std::tuple<int, std::string> pair;
+    [](gusc::Threads::Signal<int, std::string>& sig, ManualExecutor& target, std::tuple<int, std::string>& received) -> gusc::Threads::Task {
+        received = co_await gusc::Threads::next(sig, target);
+    }(sigPair, executor, pair);
+    sigPair.emit(5, std::string("five"));
+    executor.run();
+    expect(pair == std::make_tuple(5, std::string("five")), "coroutine receives all the signal arguments as a tuple");
+
+    gusc::Threads::Signal<void> sigVoid;
+    bool isResumed { false };
+    [](gusc::Threads::Signal<void>& sig, ManualExecutor& target, bool& resumed) -> gusc::Threads::Task {
+        co_await gusc::Threads::next(sig, target);
+        resumed = true;
+    }(sigVoid, executor, isResumed);
+    sigVoid.emit();
+    executor.run();
+    expect(isResumed, "coroutine awaits signals without arguments");
+}
+
+void testNextEmissionOnThread()
+{
+    constexpr int emissionCount { 1000 };
+    gusc::Threads::Thread worker;
+    gusc::Threads::Signal<int> sig;
+    std::promise<int> done;
+    worker.start();
+
+    // Emit from another thread as fast as possible, the coroutine picks up whatever comes next
+    [](gusc::Threads::Signal<int>& signal, gusc::Threads::Thread& target, std::promise<int>& result) -> gusc::Threads::Task {
+        int last { -1 };
+        int count { 0 };
+        while (last < emissionCount - 1)
+        {
+            const int value = co_await gusc::Threads::next(signal, target);
+            if (value <= last || !target.isCurrent())
+            {
+                count = -1;
+                break;
+            }
+            last = value;
+            ++count;
+        }
+        result.set_value(count);
+    }(sig, worker, done);
+
+    auto future = done.get_future();
+    for (int i = 0; i < emissionCount; ++i)
+    {
+        sig.emit(i);
+    }
+    // Keep emitting the last value until the coroutine has seen it
+    while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+    {
+        sig.emit(emissionCount - 1);
+    }
+    const int count = future.get();
+    expect(count > 0, "coroutine receives increasing values on it's thread");
+    worker.stop();
+    worker.join();
+    clog << "Coroutine emissions received: " + std::to_string(count);
+}
+
+void runCoroutineTests()
+{
+    clog << "Coroutine Tests";
+    testSchedule();
+    testNextEmission();
+    testNextEmissionOnThread();
+}
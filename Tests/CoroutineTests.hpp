@@ -0,0 +1,13 @@
+//
+//  CoroutineTests.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef CoroutineTests_hpp
+#define CoroutineTests_hpp
+
+void runCoroutineTests();
+
+#endif /* CoroutineTests_hpp */
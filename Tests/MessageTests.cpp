@@ -0,0 +1,234 @@
+//
+//  MessageTests.cpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#include "MessageTests.hpp"
+#include "Utilities.hpp"
+#include "Message.hpp"
+#include "Delegate.hpp"
+#include "Thread.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace
+{
+static Logger mlog;
+std::atomic<std::size_t> allocationCount { 0 };
+}
+
+// Count every heap allocation made by the test executable
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+struct LargeCallable
+{
+    std::array<char, gusc::Threads::Message::InlineSize + 1> payload {};
+    std::atomic<std::size_t>* counter { nullptr };
+    void operator()() const
+    {
+        counter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/// @brief send a batch of messages and wait until they are processed
+/// @return number of heap allocations made while sending and processing
+template<typename TMakeCallable>
+std::size_t countAllocations(gusc::Threads::Thread& thread, std::atomic<std::size_t>& counter, std::size_t messageCount, const TMakeCallable& makeCallable)
+{
+    counter = 0;
+    const auto before = allocationCount.load();
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        thread.send(makeCallable());
+    }
+    while (counter.load() != messageCount)
+    {
+        std::this_thread::yield();
+    }
+    return allocationCount.load() - before;
+}
+
+void testMessageStorage()
+{
+    std::size_t calls { 0 };
+    gusc::Threads::Message small([&calls](){ ++calls; });
+    small();
+    gusc::Threads::Message moved(std::move(small));
+    moved();
+    expect(calls == 2, "inline message is callable after move");
+    expect(!small, "moved-from message is empty");
+    
+    std::atomic<std::size_t> counter { 0 };
+    gusc::Threads::Message large(LargeCallable{{}, &counter});
+    gusc::Threads::Message movedLarge(std::move(large));
+    movedLarge();
+    expect(counter == 1, "heap message is callable after move");
+    
+    gusc::Threads::Message emplaced;
+    emplaced.emplace(std::move(moved));
+    emplaced();
+    expect(calls == 3 && !moved, "emplacing a message takes over its callable");
+    emplaced.emplace(std::move(emplaced));
+    emplaced();
+    expect(calls == 4, "emplacing a message into itself keeps the callable");
+    
+    static_assert(!gusc::Threads::Message::isInline<LargeCallable>(), "large callables are stored on the heap");
+}
+
+void testSendAllocations()
+{
+    constexpr std::size_t messageCount { 500 };
+    constexpr std::size_t warmUpRounds { 4 };
+    constexpr std::size_t roundCount { 20 };
+    
+    gusc::Threads::Thread thread;
+    std::atomic<std::size_t> counter { 0 };
+    thread.start();
+    
+    int a { 0 };
+    int b { 0 };
+    const auto makeSmall = [&counter, &a, &b](){
+        return [&counter, pa = &a, pb = &b](){
+            (void)pa;
+            (void)pb;
+            counter.fetch_add(1, std::memory_order_relaxed);
+        };
+    };
+    // Fill the node pool
+    for (std::size_t i = 0; i < warmUpRounds; ++i)
+    {
+        countAllocations(thread, counter, messageCount, makeSmall);
+    }
+    // Nodes kept in the thread caches don't depend on the number of messages sent, so the allocations stay bounded
+    std::size_t smallAllocations { 0 };
+    for (std::size_t i = 0; i < roundCount; ++i)
+    {
+        smallAllocations += countAllocations(thread, counter, messageCount, makeSmall);
+    }
+    expect(smallAllocations < messageCount, "sending small callables does not allocate in a steady state");
+    
+    std::size_t largeAllocations { 0 };
+    for (std::size_t i = 0; i < roundCount; ++i)
+    {
+        largeAllocations += countAllocations(thread, counter, messageCount, [&counter](){
+            return LargeCallable{{}, &counter};
+        });
+    }
+    expect(largeAllocations >= roundCount * messageCount && largeAllocations < (roundCount + 1) * messageCount, "sending large callables allocates once per message");
+    
+    thread.stop();
+    thread.join();
+    mlog << "Small callable allocations: " + std::to_string(smallAllocations) + ", large callable allocations: " + std::to_string(largeAllocations);
+}
+
+/// @brief thread local that uses the node pool from it's destructor
+struct LateNodeUser
+{
+    std::atomic<bool>* isDone { nullptr };
+    gusc::Threads::MessageNodePtr node;
+    ~LateNodeUser()
+    {
+        if (isDone)
+        {
+            node.reset();
+            gusc::Threads::MessageNodePtr another(gusc::Threads::MessageNodePool::acquire());
+            another->message.emplace([](){});
+            another.reset();
+            *isDone = true;
+        }
+    }
+};
+
+void testNodePoolTeardown()
+{
+    std::atomic<bool> isDone { false };
+    std::thread thread([&isDone](){
+        // Thread locals are destroyed in reverse order, so the user created before the pool's cache is destroyed after it
+        static thread_local LateNodeUser user;
+        user.isDone = &isDone;
+        user.node = gusc::Threads::MessageNodePtr(gusc::Threads::MessageNodePool::acquire());
+    });
+    thread.join();
+    expect(isDone, "node pool can be used by thread locals destroyed after it's cache");
+}
+
+int addValues(int a, int b)
+{
+    return a + b;
+}
+
+struct Accumulator
+{
+    int add(int a, int b)
+    {
+        total += a + b;
+        return total;
+    }
+    int total { 0 };
+};
+
+void testDelegateStorage()
+{
+    using IntDelegate = gusc::Threads::Delegate<int(int, int)>;
+    Accumulator accumulator;
+    int offset { 10 };
+    
+    const auto before = allocationCount.load();
+    IntDelegate function(&addValues);
+    IntDelegate method(&accumulator, &Accumulator::add);
+    IntDelegate lambda([&offset](int a, int b){ return a + b + offset; });
+    IntDelegate copied(lambda);
+    IntDelegate moved(std::move(method));
+    const auto allocations = allocationCount.load() - before;
+    
+    expect(allocations == 0, "function pointers, member functions and small lambdas are stored without allocation");
+    expect(function(1, 2) == 3, "delegate calls a function pointer");
+    expect(moved(1, 2) == 3 && moved(1, 2) == 6, "delegate calls a member function on an object");
+    expect(copied(1, 2) == 13, "copied delegate calls the lambda");
+    expect(!method, "moved-from delegate is empty");
+    
+    const std::string prefix(64, 'x');
+    gusc::Threads::Delegate<std::size_t(const std::string&)> large([prefix](const std::string& value){
+        return prefix.size() + value.size();
+    });
+    auto largeCopy = large;
+    large.reset();
+    expect(largeCopy("abc") == 67, "delegate keeps a copy of a non-trivial callable");
+    
+    static_assert(IntDelegate::isInline<decltype(&addValues)>(), "function pointers are stored inline");
+    static_assert(!IntDelegate::isInline<LargeCallable>(), "large callables are stored on the heap");
+}
+
+void runMessageTests()
+{
+    mlog << "Message Tests";
+    testMessageStorage();
+    testSendAllocations();
+    testNodePoolTeardown();
+    testDelegateStorage();
+}
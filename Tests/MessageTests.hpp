@@ -0,0 +1,13 @@
+//
+//  MessageTests.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef MessageTests_hpp
+#define MessageTests_hpp
+
+void runMessageTests();
+
+#endif /* MessageTests_hpp */
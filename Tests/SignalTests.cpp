@@ -10,8 +10,18 @@
 #include "Utilities.hpp"
 #include "Thread.hpp"
 #include "Signal.hpp"
+#include "Snapshot.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -113,6 +123,594 @@ static const auto objectLambda = [](const Object& o){
    slog << "Object lambda thread ID: " + tidToStr(std::this_thread::get_id()) + ", " + o.getVal();
 };
 
+/// @brief executor that runs everything on the calling thread
+class InlineExecutor : public gusc::Threads::Executor
+{
+public:
+    bool isCurrent() const noexcept override
+    {
+        return true;
+    }
+    void post(gusc::Threads::Message&& message) override
+    {
+        message();
+    }
+};
+
+void testEmitWhileConnecting()
+{
+    constexpr std::size_t emitCount { 10000 };
+    InlineExecutor executor;
+    gusc::Threads::Signal<int> sig;
+    std::atomic<std::size_t> permanentCalls { 0 };
+    std::atomic<std::size_t> selfDisconnectCalls { 0 };
+    
+    sig.connect(&executor, [&](const int&){
+        ++permanentCalls;
+    });
+    // Disconnecting from within a listener must not deadlock
+    std::size_t selfId { 0 };
+    selfId = sig.connect(&executor, [&](const int&){
+        ++selfDisconnectCalls;
+        sig.disconnect(selfId);
+    });
+    sig.emit(0);
+    
+    std::vector<std::thread> threads;
+    for (int e = 0; e < 2; ++e)
+    {
+        threads.emplace_back([&](){
+            for (std::size_t i = 0; i < emitCount; ++i)
+            {
+                sig.emit(static_cast<int>(i));
+            }
+        });
+    }
+    threads.emplace_back([&](){
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            sig.disconnect(sig.connect(&executor, [](const int&){}));
+        }
+    });
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    
+    expect(selfDisconnectCalls == 1, "listener can disconnect itself during emission");
+    expect(permanentCalls == emitCount * 2 + 1, "emission is not disturbed by concurrent connects and disconnects");
+    slog << "Emit while connecting done";
+}
+
+/// @brief snapshot value that can tell if it has been destroyed
+struct CheckedValue
+{
+    static constexpr std::size_t AliveMark { 0x5eed };
+    explicit CheckedValue(std::size_t initValue)
+        : value(initValue)
+    {}
+    ~CheckedValue()
+    {
+        mark = 0;
+    }
+    std::size_t value { 0 };
+    std::size_t mark { AliveMark };
+};
+
+void testSnapshotWriters()
+{
+    constexpr std::size_t writerCount { 3 };
+    constexpr std::size_t readerCount { 3 };
+    constexpr std::size_t storeCount { 5000 };
+    gusc::Threads::Snapshot<CheckedValue> snapshot(0);
+    std::mutex writerMutex;
+    std::atomic<std::size_t> activeWriters { writerCount };
+    std::atomic<std::size_t> deadReads { 0 };
+    std::atomic<std::size_t> readCount { 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t w = 0; w < writerCount; ++w)
+    {
+        threads.emplace_back([&](){
+            for (std::size_t i = 1; i <= storeCount; ++i)
+            {
+                // Snapshot writers are serialized by the owner (Signal uses it's connect mutex)
+                std::lock_guard<std::mutex> lock(writerMutex);
+                snapshot.store(i);
+            }
+            --activeWriters;
+        });
+    }
+    for (std::size_t r = 0; r < readerCount; ++r)
+    {
+        threads.emplace_back([&](){
+            while (activeWriters)
+            {
+                const auto reference = snapshot.load();
+                if (reference->mark != CheckedValue::AliveMark)
+                {
+                    ++deadReads;
+                }
+                ++readCount;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    expect(deadReads == 0, "snapshot readers never see a value released by concurrent writers");
+    slog << "Snapshot reads during stores: " + std::to_string(readCount.load());
+}
+
+void testConnectionChurn()
+{
+    constexpr std::size_t subscriberCount { 10000 };
+    InlineExecutor executor;
+    gusc::Threads::Signal<int> sig;
+    std::vector<int> order;
+    std::vector<std::size_t> ids;
+    
+    for (std::size_t i = 0; i < subscriberCount; ++i)
+    {
+        ids.push_back(sig.connect(&executor, [&order, i](const int&){
+            order.push_back(static_cast<int>(i));
+        }));
+    }
+    // Disconnect every second subscriber, which triggers compaction
+    bool isDisconnected { true };
+    for (std::size_t i = 0; i < subscriberCount; i += 2)
+    {
+        isDisconnected = sig.disconnect(ids[i]) && isDisconnected;
+    }
+    expect(isDisconnected, "connected subscribers are disconnected by their ID");
+    expect(!sig.disconnect(ids[0]), "disconnected ID is not valid anymore");
+    // Reuses the freed storage, but must get a new ID
+    const auto reusedId = sig.connect(&executor, [&order](const int&){
+        order.push_back(-1);
+    });
+    expect(std::find(ids.begin(), ids.end(), reusedId) == ids.end(), "connection IDs are never reused");
+    
+    sig.emit(0);
+    bool isOrdered { order.size() == subscriberCount / 2 + 1 };
+    for (std::size_t i = 0; isOrdered && i < subscriberCount / 2; ++i)
+    {
+        isOrdered = order[i] == static_cast<int>(i * 2 + 1);
+    }
+    expect(isOrdered && order.back() == -1, "remaining subscribers are called in connection order");
+    
+    // Interleaved targets keep their connection order across store growth and compaction
+    constexpr std::size_t mixedCount { 1000 };
+    InlineExecutor otherExecutor;
+    gusc::Threads::Signal<int> mixed;
+    std::vector<int> mixedOrder;
+    std::vector<std::size_t> mixedIds;
+    for (std::size_t i = 0; i < mixedCount; ++i)
+    {
+        mixedIds.push_back(mixed.connect(i % 2 ? &otherExecutor : &executor, [&mixedOrder, i](const int&){
+            mixedOrder.push_back(static_cast<int>(i));
+        }));
+    }
+    // Disconnecting two out of three subscribers compacts the store on the way
+    std::vector<int> expectedOrder;
+    for (std::size_t i = 0; i < mixedCount; ++i)
+    {
+        if (i % 3)
+        {
+            mixed.disconnect(mixedIds[i]);
+        }
+        else if (i % 2 == 0)
+        {
+            expectedOrder.push_back(static_cast<int>(i));
+        }
+    }
+    for (std::size_t i = 3; i < mixedCount; i += 6)
+    {
+        expectedOrder.push_back(static_cast<int>(i));
+    }
+    mixed.emit(0);
+    expect(mixedOrder == expectedOrder, "subscribers are called in connection order per target after compaction");
+    slog << "Connection churn done";
+}
+
+/// @brief signal argument that counts how many times it's copied
+struct CopyCounter
+{
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter&)
+    {
+        ++copies;
+    }
+    CopyCounter(CopyCounter&&) noexcept = default;
+    static std::atomic<std::size_t> copies;
+};
+std::atomic<std::size_t> CopyCounter::copies { 0 };
+
+void testSharedPayload()
+{
+    constexpr std::size_t listenerCount { 4 };
+    gusc::Threads::Thread thread;
+    gusc::Threads::Signal<CopyCounter> sig;
+    std::atomic<std::size_t> calls { 0 };
+    std::promise<void> isDone;
+    
+    for (std::size_t i = 0; i < listenerCount; ++i)
+    {
+        sig.connect(&thread, [&](const CopyCounter&){
+            if (++calls == listenerCount)
+            {
+                isDone.set_value();
+            }
+        });
+    }
+    thread.start();
+    CopyCounter::copies = 0;
+    const CopyCounter value;
+    sig.emit(value);
+    isDone.get_future().wait();
+    expect(CopyCounter::copies == 1, "signal arguments are copied once for all the queued listeners");
+    
+    calls = 0;
+    isDone = std::promise<void>();
+    CopyCounter::copies = 0;
+    sig.emit(CopyCounter{});
+    isDone.get_future().wait();
+    expect(CopyCounter::copies == 0, "temporary signal arguments are moved to the queued listeners");
+    
+    thread.stop();
+    thread.join();
+    slog << "Shared payload done";
+}
+
+void testMoveOnlyArguments()
+{
+    gusc::Threads::Thread thread;
+    gusc::Threads::Signal<std::unique_ptr<int>> sig;
+    std::promise<int> received;
+    
+    sig.connect(&thread, [&](const std::unique_ptr<int>& value){
+        received.set_value(*value);
+    });
+    thread.start();
+    sig.emit(std::make_unique<int>(42));
+    
+    expect(received.get_future().get() == 42, "move-only signal arguments are handed over to another thread");
+    thread.stop();
+    thread.join();
+    slog << "Move-only arguments done";
+}
+
+/// @brief executor that keeps the posted messages until they are run manually
+class ManualExecutor : public gusc::Threads::Executor
+{
+public:
+    explicit ManualExecutor(bool initIsCurrent = false)
+        : isCurrentThread(initIsCurrent)
+    {}
+    bool isCurrent() const noexcept override
+    {
+        return isCurrentThread;
+    }
+    void post(gusc::Threads::Message&& message) override
+    {
+        messages.emplace_back(std::move(message));
+    }
+    void run()
+    {
+        for (auto& message : messages)
+        {
+            message();
+        }
+        messages.clear();
+    }
+    std::vector<gusc::Threads::Message> messages;
+    const bool isCurrentThread { false };
+};
+
+void testCoalescedTargets()
+{
+    ManualExecutor first;
+    ManualExecutor second;
+    gusc::Threads::Signal<int> sig;
+    std::vector<int> order;
+    
+    for (int i = 0; i < 6; ++i)
+    {
+        sig.connect(i % 2 ? &second : &first, [&order, i](const int&){
+            order.push_back(i);
+        });
+    }
+    sig.emit(1);
+    
+    expect(first.messages.size() == 1 && second.messages.size() == 1, "a single message is posted per target thread");
+    first.run();
+    second.run();
+    expect(order == std::vector<int>{0, 2, 4, 1, 3, 5}, "slots of a target thread are called in connection order");
+    slog << "Coalesced targets done";
+}
+
+void testDeferredDisconnect()
+{
+    constexpr std::size_t oneShotCount { 1000 };
+    InlineExecutor executor;
+    gusc::Threads::Signal<int> sig;
+    std::size_t calls { 0 };
+    
+    // One-shot listeners unsubscribe themselves on the first call
+    for (std::size_t i = 0; i < oneShotCount; ++i)
+    {
+        auto id = std::make_shared<std::size_t>(0);
+        *id = sig.connect(&executor, [&sig, &calls, id](const int&){
+            ++calls;
+            sig.disconnect(*id);
+        });
+    }
+    // A listener that disconnects the one connected after it
+    std::size_t victimCalls { 0 };
+    std::size_t victimId { 0 };
+    sig.connect(&executor, [&sig, &victimId](const int&){
+        sig.disconnect(victimId);
+    });
+    victimId = sig.connect(&executor, [&victimCalls](const int&){
+        ++victimCalls;
+    });
+    sig.emit(1);
+    sig.emit(2);
+    expect(calls == oneShotCount, "one-shot listeners are called once");
+    expect(victimCalls == 0, "listener disconnected during the emission is not called");
+    
+    // Queued delivery of a disconnected listener is skipped
+    ManualExecutor manual;
+    std::size_t queuedCalls { 0 };
+    const auto queuedId = sig.connect(&manual, [&queuedCalls](const int&){
+        ++queuedCalls;
+    });
+    sig.emit(3);
+    sig.disconnect(queuedId);
+    manual.run();
+    expect(queuedCalls == 0, "queued delivery of a disconnected listener is skipped");
+    slog << "Deferred disconnect done";
+}
+
+void testDisconnectAndWait()
+{
+    InlineExecutor executor;
+    gusc::Threads::Signal<int> sig;
+    std::promise<void> entered;
+    std::promise<void> released;
+    auto isReleased = released.get_future();
+    std::atomic<bool> isCallDone { false };
+    const auto id = sig.connect(&executor, [&](const int&){
+        entered.set_value();
+        isReleased.wait();
+        isCallDone = true;
+    });
+    std::thread emitter([&](){
+        sig.emit(1);
+    });
+    entered.get_future().wait();
+    std::atomic<bool> isDisconnected { false };
+    std::thread disconnecter([&](){
+        isDisconnected = sig.disconnectAndWait(id);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    expect(!isDisconnected, "disconnect and wait does not return while the listener is running on another thread");
+    released.set_value();
+    disconnecter.join();
+    emitter.join();
+    expect(isDisconnected && isCallDone, "disconnect and wait returns once the running call is done");
+    
+    // A listener can disconnect itself and wait without waiting for its own call
+    std::size_t selfId { 0 };
+    bool isSelfDisconnected { false };
+    selfId = sig.connect(&executor, [&](const int&){
+        isSelfDisconnected = sig.disconnectAndWait(selfId);
+    });
+    sig.emit(2);
+    expect(isSelfDisconnected, "listener can disconnect itself and wait");
+    slog << "Disconnect and wait done";
+}
+
+void testConnectionTypes()
+{
+    using gusc::Threads::ConnectionType;
+    ManualExecutor other;
+    ManualExecutor current(true);
+    gusc::Threads::Signal<int> sig;
+    std::vector<std::string> calls;
+    
+    sig.connect(&other, [&calls](const int&){
+        calls.push_back("direct");
+    }, ConnectionType::Direct);
+    sig.connect(&current, [&calls](const int&){
+        calls.push_back("queued");
+    }, ConnectionType::Queued);
+    sig.connect(&current, [&calls](const int&){
+        calls.push_back("auto");
+    });
+    sig.connect(&current, [&calls](const int&){
+        calls.push_back("blocking");
+    }, ConnectionType::BlockingQueued);
+    sig.emit(1);
+    
+    expect(calls == std::vector<std::string>{"direct", "auto", "blocking"}, "direct, auto and blocking listeners on the emitting thread are called directly");
+    expect(other.messages.empty() && current.messages.size() == 1, "queued listener is queued even on the emitting thread");
+    current.run();
+    expect(calls.back() == "queued", "queued listener is called by its thread");
+    
+    gusc::Threads::Thread thread;
+    gusc::Threads::Signal<int> blockingSig;
+    std::atomic<bool> isCalled { false };
+    std::thread::id listenerThread;
+    blockingSig.connect(&thread, [&](const int&){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        listenerThread = std::this_thread::get_id();
+        isCalled = true;
+    }, ConnectionType::BlockingQueued);
+    thread.start();
+    blockingSig.emit(1);
+    expect(isCalled && listenerThread != std::this_thread::get_id(), "blocking queued emission returns after the listener is done on its thread");
+    thread.stop();
+    thread.join();
+    slog << "Connection types done";
+}
+
+void testConflatedConnections()
+{
+    ManualExecutor slow;
+    gusc::Threads::Signal<int> sig;
+    std::vector<int> latest;
+    std::vector<int> all;
+    
+    sig.connect(&slow, [&latest](const int& value){
+        latest.push_back(value);
+    }, gusc::Threads::ConnectionType::Conflated);
+    sig.connect(&slow, [&all](const int& value){
+        all.push_back(value);
+    }, gusc::Threads::ConnectionType::Queued);
+    for (int i = 1; i <= 3; ++i)
+    {
+        sig.emit(i);
+    }
+    expect(slow.messages.size() == 4, "conflated connection keeps a single pending delivery");
+    slow.run();
+    expect(latest == std::vector<int>{3}, "conflated listener only receives the latest value");
+    expect(all == std::vector<int>{1, 2, 3}, "queued listener receives every value");
+    
+    sig.emit(4);
+    slow.run();
+    expect(latest == std::vector<int>{3, 4}, "conflated listener receives the next value after the pending one is delivered");
+    
+    constexpr int emitCount { 10000 };
+    gusc::Threads::Thread thread;
+    std::atomic<int> lastValue { 0 };
+    std::atomic<int> deliveries { 0 };
+    sig.connect(&thread, [&](const int& value){
+        lastValue = value;
+        ++deliveries;
+    }, gusc::Threads::ConnectionType::Conflated);
+    thread.start();
+    for (int i = 1; i <= emitCount; ++i)
+    {
+        sig.emit(i);
+    }
+    thread.stop();
+    thread.join();
+    expect(lastValue == emitCount && deliveries <= emitCount, "conflated listener on another thread ends with the latest value");
+    
+    // A dropped delivery does not block the following ones
+    gusc::Threads::Thread bounded(2, gusc::Threads::OverflowPolicy::DropOldest);
+    gusc::Threads::Signal<int> droppedSig;
+    std::vector<int> received;
+    droppedSig.connect(&bounded, [&received](const int& value){
+        received.push_back(value);
+    }, gusc::Threads::ConnectionType::Conflated);
+    std::promise<void> isBusy;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    bounded.start();
+    bounded.send([&isBusy, released](){
+        isBusy.set_value();
+        released.wait();
+    });
+    isBusy.get_future().wait();
+    droppedSig.emit(1);
+    bounded.send([](){});
+    bounded.send([](){});
+    release.set_value();
+    droppedSig.emit(2);
+    bounded.stop();
+    bounded.join();
+    expect(received == std::vector<int>{2}, "conflated listener receives the next value after the pending delivery was dropped");
+    slog << "Conflated connections done";
+}
+
+void testPrioritySlots()
+{
+    using gusc::Threads::ConnectionType;
+    using gusc::Threads::Priority;
+    gusc::Threads::Thread thread;
+    gusc::Threads::Signal<int> sig;
+    std::vector<int> order;
+    sig.connect(&thread, [&order](const int& value){
+        order.push_back(value * 10);
+    }, ConnectionType::Queued, Priority::Low);
+    sig.connect(&thread, [&order](const int& value){
+        order.push_back(value);
+    }, ConnectionType::Queued, Priority::High);
+    sig.emit(1);
+    sig.emit(2);
+    thread.start();
+    thread.invoke([](){}, Priority::Low).get();
+    expect(order == std::vector<int>({ 1, 2, 10, 20 }), "high priority listeners are delivered before low priority ones on the same thread");
+    thread.stop();
+    thread.join();
+}
+
+void testThreadPoolSlots()
+{
+    gusc::Threads::ThreadPool pool(2);
+    gusc::Threads::Signal<int> sig;
+    std::promise<std::thread::id> listenerThread;
+    std::promise<int> listenerValue;
+    
+    sig.connect(&pool, [&](const int& value){
+        listenerThread.set_value(std::this_thread::get_id());
+        listenerValue.set_value(value);
+    });
+    pool.start();
+    sig.emit(7);
+    
+    expect(listenerValue.get_future().get() == 7, "thread pool slot receives signal data");
+    expect(listenerThread.get_future().get() != std::this_thread::get_id(), "thread pool slot is executed on a pool worker");
+    
+    // Listeners of a single emission run in parallel - each waits until the other one has started
+    gusc::Threads::Signal<int> parallelSig;
+    std::atomic<int> startedCount { 0 };
+    std::atomic<int> parallelCount { 0 };
+    const auto waitForOther = [&](const int&){
+        ++startedCount;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (startedCount < 2 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+        if (startedCount >= 2)
+        {
+            ++parallelCount;
+        }
+    };
+    parallelSig.connect(&pool, waitForOther);
+    parallelSig.connect(&pool, waitForOther);
+    parallelSig.emit(1);
+    while (startedCount < 2)
+    {
+        std::this_thread::yield();
+    }
+    pool.stop();
+    pool.join();
+    expect(parallelCount == 2, "thread pool listeners of a single emission run in parallel");
+    slog << "Thread pool slot done";
+}
+
+void testStrandSlots()
+{
+    gusc::Threads::ThreadPool pool(2);
+    gusc::Threads::Strand strand(pool);
+    gusc::Threads::Signal<int> sig;
+    std::promise<bool> isOnStrand;
+    
+    sig.connect(&strand, [&](const int&){
+        isOnStrand.set_value(strand.isCurrent());
+    });
+    pool.start();
+    sig.emit(1);
+    
+    expect(isOnStrand.get_future().get(), "strand slot is executed on the strand");
+    pool.stop();
+    pool.join();
+    slog << "Strand slot done";
+}
+
 void runSignalTests()
 {
     slog << "Signal Tests";
@@ -211,7 +809,7 @@ void runSignalTests()
     sigSimple.disconnect(idxMtSimple4);
     sigSimple.disconnect(idxMtSimple5);
     
-    sigArgs.disconnect(&mt, &argumentFunction);
+    expect(sigArgs.disconnect(&mt, &argumentFunction), "free function listener is disconnected by it's pointer");
     sigArgs.disconnect(idxMtArgs2);
     sigArgs.disconnect(idxMtArgs3);
     sigArgs.disconnect(idxMtArgs4);
@@ -244,4 +842,18 @@ void runSignalTests()
     sigSimple.disconnect(&ct, &CustomThread::listenSimple);
     sigArgs.disconnect(&ct, &CustomThread::listenArgs);
     sigObject.disconnect(&ct, &CustomThread::listenObject);
+    
+    testEmitWhileConnecting();
+    testSnapshotWriters();
+    testConnectionChurn();
+    testSharedPayload();
+    testMoveOnlyArguments();
+    testCoalescedTargets();
+    testDeferredDisconnect();
+    testDisconnectAndWait();
+    testConnectionTypes();
+    testConflatedConnections();
+    testPrioritySlots();
+    testThreadPoolSlots();
+    testStrandSlots();
 }
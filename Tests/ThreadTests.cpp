@@ -10,6 +10,15 @@
 #include "Utilities.hpp"
 #include "Thread.hpp"
 
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <future>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
 namespace
 {
 static Logger tlog;
@@ -50,6 +59,1097 @@ static auto globalLambda = [](){
 };
 
 
+void testMultipleProducers()
+{
+    constexpr std::size_t producerCount { 8 };
+    constexpr std::size_t messageCount { 10000 };
+    
+    gusc::Threads::Thread consumer;
+    // Only accessed from the consumer thread
+    std::vector<std::size_t> lastReceived(producerCount, 0);
+    std::size_t outOfOrder { 0 };
+    std::size_t received { 0 };
+    
+    consumer.start();
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&, p](){
+            for (std::size_t i = 1; i <= messageCount; ++i)
+            {
+                consumer.send([&, p, i](){
+                    if (lastReceived[p] + 1 != i)
+                    {
+                        ++outOfOrder;
+                    }
+                    lastReceived[p] = i;
+                    ++received;
+                });
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    consumer.stop();
+    consumer.join();
+    
+    expect(received == producerCount * messageCount, "all messages from multiple producers are received");
+    expect(outOfOrder == 0, "messages from a single producer are received in FIFO order");
+    tlog << "Multiple producers received: " + std::to_string(received);
+}
+
+void testMoveOnlyMessages()
+{
+    gusc::Threads::Thread worker;
+    worker.start();
+    
+    // Move-only callable
+    auto owned = std::make_unique<int>(42);
+    std::promise<int> ownedResult;
+    worker.send([value = std::move(owned), &ownedResult](){
+        ownedResult.set_value(*value);
+    });
+    expect(ownedResult.get_future().get() == 42, "move-only callable is executed");
+    
+    // Large payload is handed over without a deep copy
+    std::vector<int> buffer(1024, 1);
+    const int* const bufferData = buffer.data();
+    std::promise<const int*> bufferResult;
+    worker.send([payload = std::move(buffer), &bufferResult](){
+        bufferResult.set_value(payload.data());
+    });
+    expect(bufferResult.get_future().get() == bufferData, "moved payload is not copied");
+    
+    worker.stop();
+    worker.join();
+    tlog << "Move-only messages done";
+}
+
+void testSendBatch()
+{
+    constexpr std::size_t producerCount { 4 };
+    constexpr std::size_t batchCount { 100 };
+    constexpr std::size_t batchSize { 50 };
+    
+    gusc::Threads::Thread consumer;
+    // Only accessed from the consumer thread
+    std::vector<std::size_t> executionOrder;
+    consumer.start();
+    
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&, p](){
+            for (std::size_t b = 0; b < batchCount; ++b)
+            {
+                std::vector<std::function<void()>> batch;
+                for (std::size_t i = 0; i < batchSize; ++i)
+                {
+                    batch.emplace_back([&executionOrder, p](){
+                        executionOrder.push_back(p);
+                    });
+                }
+                consumer.sendBatch(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    consumer.stop();
+    consumer.join();
+    
+    bool isContiguous { true };
+    for (std::size_t i = 0; i < executionOrder.size(); i += batchSize)
+    {
+        for (std::size_t j = i; j < i + batchSize && j < executionOrder.size(); ++j)
+        {
+            isContiguous = isContiguous && executionOrder[j] == executionOrder[i];
+        }
+    }
+    expect(executionOrder.size() == producerCount * batchCount * batchSize, "all batched messages are received");
+    expect(isContiguous, "messages of a single batch are executed back to back");
+    tlog << "Batched messages received: " + std::to_string(executionOrder.size());
+}
+
+void testBoundedThread()
+{
+    using gusc::Threads::OverflowPolicy;
+    using gusc::Threads::Priority;
+    constexpr std::size_t capacity { 4 };
+    
+    // Fail fast
+    {
+        gusc::Threads::Thread bounded(capacity, OverflowPolicy::Fail);
+        std::vector<std::size_t> executed;
+        bool isAccepted { true };
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            isAccepted = bounded.trySend([&executed, i](){ executed.push_back(i); }) && isAccepted;
+        }
+        expect(isAccepted, "bounded thread accepts messages up to its capacity");
+        expect(!bounded.trySend([](){}), "trySend fails when the bounded queue is full");
+        bool isThrown { false };
+        try
+        {
+            bounded.send([](){});
+        }
+        catch (const std::runtime_error&)
+        {
+            isThrown = true;
+        }
+        expect(isThrown, "send throws when the bounded queue is full and the policy is Fail");
+        bounded.start();
+        bounded.stop();
+        bounded.join();
+        expect(executed.size() == capacity, "all accepted messages of a bounded thread are executed");
+    }
+    
+    // Drop oldest
+    {
+        gusc::Threads::Thread bounded(capacity, OverflowPolicy::DropOldest);
+        std::vector<std::size_t> executed;
+        for (std::size_t i = 0; i < capacity * 2; ++i)
+        {
+            bounded.send([&executed, i](){ executed.push_back(i); });
+        }
+        bounded.start();
+        bounded.stop();
+        bounded.join();
+        expect(executed == std::vector<std::size_t>{4, 5, 6, 7}, "oldest messages are dropped when the bounded queue is full");
+    }
+    
+    // A batch goes through the same overflow policy as single messages, whatever its priority
+    {
+        gusc::Threads::Thread bounded(capacity, OverflowPolicy::DropOldest);
+        std::vector<std::size_t> executed;
+        std::vector<std::function<void()>> batch;
+        for (std::size_t i = 0; i < capacity + 2; ++i)
+        {
+            batch.emplace_back([&executed, i](){ executed.push_back(i); });
+        }
+        bounded.sendBatch(batch.begin(), batch.end(), Priority::High);
+        bounded.start();
+        bounded.stop();
+        bounded.join();
+        expect(executed == std::vector<std::size_t>{2, 3, 4, 5}, "bounded thread pushes a high priority batch through the overflow policy");
+    }
+    
+    // Block the sender
+    {
+        constexpr std::size_t messageCount { 1000 };
+        gusc::Threads::Thread bounded(capacity, OverflowPolicy::Block);
+        std::size_t received { 0 };
+        std::atomic<bool> isSending { true };
+        std::thread producer([&](){
+            for (std::size_t i = 0; i < messageCount; ++i)
+            {
+                bounded.send([&received](){ ++received; });
+            }
+            isSending = false;
+        });
+        // Producer is blocked until the consumer is started
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        expect(isSending, "sender is blocked while the bounded queue is full");
+        bounded.start();
+        producer.join();
+        bounded.stop();
+        bounded.join();
+        expect(received == messageCount, "blocked sender delivers all messages");
+        tlog << "Bounded thread received: " + std::to_string(received);
+    }
+    
+    // The thread never blocks on its own full queue
+    {
+        gusc::Threads::Thread bounded(capacity, OverflowPolicy::Block);
+        std::size_t accepted { 0 };
+        bool isThrown { false };
+        std::promise<void> done;
+        bounded.send([&](){
+            try
+            {
+                for (std::size_t i = 0; i <= capacity; ++i)
+                {
+                    bounded.send([](){});
+                    ++accepted;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                isThrown = true;
+            }
+            done.set_value();
+        });
+        bounded.start();
+        expect(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, "thread sending to its own full queue does not deadlock");
+        bounded.stop();
+        bounded.join();
+        expect(accepted == capacity && isThrown, "send to its own full queue throws instead of blocking");
+    }
+    
+    // A single slot queue
+    {
+        gusc::Threads::Thread bounded(1, OverflowPolicy::DropOldest);
+        std::vector<std::size_t> executed;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            bounded.send([&executed, i](){ executed.push_back(i); });
+        }
+        bounded.start();
+        bounded.stop();
+        bounded.join();
+        expect(executed == std::vector<std::size_t>{2}, "queue of capacity 1 keeps a single message");
+    }
+}
+
+void testLeftovers()
+{
+    // Messages sent from the thread itself while draining are executed
+    {
+        gusc::Threads::Thread worker;
+        std::vector<std::size_t> executed;
+        worker.send([&](){
+            executed.push_back(1);
+            worker.send([&executed](){ executed.push_back(2); });
+        });
+        worker.start();
+        worker.stop();
+        worker.join();
+        expect(executed == std::vector<std::size_t>{1, 2}, "leftover message can send to its own thread");
+    }
+    
+    // A thread that never runs out of messages still sees stop()
+    {
+        gusc::Threads::Thread worker;
+        worker.setDrainTimeout(std::chrono::milliseconds(10));
+        std::atomic<std::size_t> executed { 0 };
+        std::function<void()> chain = [&](){
+            ++executed;
+            worker.send([&chain](){ chain(); });
+        };
+        worker.send([&chain](){ chain(); });
+        worker.start();
+        while (executed < 1000)
+        {
+            std::this_thread::yield();
+        }
+        worker.stop();
+        worker.join();
+        expect(executed >= 1000, "busy thread stops in between message batches");
+    }
+    
+    // Drain timeout counts from stop() - the message running at that moment outlives it, so everything left is dropped
+    {
+        constexpr std::size_t messageCount { 100 };
+        gusc::Threads::Thread worker;
+        std::size_t executed { 0 };
+        std::promise<void> stopped;
+        auto isStopped = stopped.get_future();
+        worker.setDrainTimeout(std::chrono::milliseconds(10));
+        worker.send([&isStopped](){
+            isStopped.wait();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        });
+        for (std::size_t i = 0; i < messageCount; ++i)
+        {
+            worker.send([&executed](){
+                ++executed;
+            });
+        }
+        worker.start();
+        worker.stop();
+        stopped.set_value();
+        worker.join();
+        expect(executed == 0, "drain timeout counts from stop() and drops the leftover messages");
+    }
+    
+    // Without a drain timeout all the leftover messages are executed
+    {
+        constexpr std::size_t messageCount { 100 };
+        gusc::Threads::Thread worker;
+        std::size_t executed { 0 };
+        for (std::size_t i = 0; i < messageCount; ++i)
+        {
+            worker.send([&executed](){
+                ++executed;
+            });
+        }
+        worker.start();
+        worker.stop();
+        worker.join();
+        expect(executed == messageCount, "all leftover messages are executed without a drain timeout");
+    }
+}
+
+void testThreadPool()
+{
+    using gusc::Threads::Priority;
+    
+    constexpr std::size_t workerCount { 4 };
+    constexpr std::size_t messageCount { 10000 };
+    constexpr std::size_t subTaskCount { 20 };
+    
+    gusc::Threads::ThreadPool pool(workerCount);
+    std::atomic<std::size_t> executed { 0 };
+    std::atomic<bool> isAlwaysCurrent { true };
+    std::mutex idMutex;
+    std::set<std::thread::id> stealingIds;
+    std::promise<void> subTasksDone;
+    std::atomic<std::size_t> subTasksLeft { subTaskCount };
+    
+    expect(pool.getWorkerCount() == workerCount, "thread pool has the requested number of workers");
+    expect(!pool.isCurrent(), "main thread is not a pool worker");
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        // The pool has no priority lanes, the priority is accepted like on a thread and ignored
+        pool.send([&](){
+            isAlwaysCurrent = isAlwaysCurrent && pool.isCurrent();
+            ++executed;
+        }, (i % 2) ? Priority::High : Priority::Normal);
+    }
+    // Sub-tasks are pushed to the sending worker's deque, idle workers have to steal them
+    pool.send([&](){
+        for (std::size_t i = 0; i < subTaskCount; ++i)
+        {
+            pool.send([&](){
+                {
+                    std::lock_guard<std::mutex> lock(idMutex);
+                    stealingIds.insert(std::this_thread::get_id());
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                if (--subTasksLeft == 0)
+                {
+                    subTasksDone.set_value();
+                }
+            });
+        }
+    });
+    pool.start();
+    expect(subTasksDone.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, "thread pool executes messages sent from workers");
+    pool.stop();
+    pool.join();
+    
+    expect(executed == messageCount, "thread pool executes all messages");
+    expect(isAlwaysCurrent, "thread pool messages are executed on pool workers");
+    expect(stealingIds.size() > 1, "idle workers steal messages from a busy worker");
+    tlog << "Thread pool executed: " + std::to_string(executed) + ", sub-tasks ran on " + std::to_string(stealingIds.size()) + " workers";
+}
+
+void testStrands()
+{
+    constexpr std::size_t strandCount { 8 };
+    constexpr std::size_t producerCount { 4 };
+    constexpr std::size_t messageCount { 500 };
+    
+    struct StrandState
+    {
+        std::atomic<bool> isBusy { false };
+        std::vector<std::size_t> lastReceived = std::vector<std::size_t>(producerCount, 0);
+        std::size_t received { 0 };
+    };
+    
+    gusc::Threads::ThreadPool pool(4);
+    std::vector<std::unique_ptr<gusc::Threads::Strand>> strands;
+    std::vector<std::unique_ptr<StrandState>> states;
+    for (std::size_t i = 0; i < strandCount; ++i)
+    {
+        strands.emplace_back(std::make_unique<gusc::Threads::Strand>(pool));
+        states.emplace_back(std::make_unique<StrandState>());
+    }
+    std::atomic<std::size_t> concurrentCalls { 0 };
+    std::atomic<std::size_t> outOfOrder { 0 };
+    std::atomic<std::size_t> notCurrent { 0 };
+    pool.start();
+    
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&, p](){
+            for (std::size_t i = 1; i <= messageCount; ++i)
+            {
+                for (std::size_t s = 0; s < strandCount; ++s)
+                {
+                    auto& strand = *strands[s];
+                    auto& state = *states[s];
+                    strand.send([&, p, i](){
+                        if (state.isBusy.exchange(true))
+                        {
+                            ++concurrentCalls;
+                        }
+                        if (!strand.isCurrent())
+                        {
+                            ++notCurrent;
+                        }
+                        if (state.lastReceived[p] + 1 != i)
+                        {
+                            ++outOfOrder;
+                        }
+                        state.lastReceived[p] = i;
+                        ++state.received;
+                        state.isBusy = false;
+                    });
+                }
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    pool.stop();
+    pool.join();
+    
+    std::size_t received { 0 };
+    for (const auto& state : states)
+    {
+        received += state->received;
+    }
+    expect(received == strandCount * producerCount * messageCount, "strands execute all messages");
+    expect(concurrentCalls == 0, "strand messages are never executed concurrently");
+    expect(outOfOrder == 0, "strand messages are executed in FIFO order");
+    expect(notCurrent == 0, "strand is current while executing its messages");
+    expect(!strands.front()->isCurrent(), "strand is not current outside of its messages");
+    tlog << "Strands received: " + std::to_string(received);
+}
+
+/// @brief executor that keeps the posted messages until they are run manually and can refuse new ones
+class RefusingExecutor : public gusc::Threads::Executor
+{
+public:
+    bool isCurrent() const noexcept override
+    {
+        return false;
+    }
+    void post(gusc::Threads::Message&& message) override
+    {
+        if (isRefusing)
+        {
+            throw std::runtime_error("Executor is refusing messages");
+        }
+        messages.emplace_back(std::move(message));
+    }
+    /// @return number of messages that threw
+    std::size_t run()
+    {
+        std::size_t thrownCount { 0 };
+        while (!messages.empty())
+        {
+            auto message = std::move(messages.front());
+            messages.erase(messages.begin());
+            try
+            {
+                message();
+            }
+            catch (const std::runtime_error&)
+            {
+                ++thrownCount;
+            }
+        }
+        return thrownCount;
+    }
+    std::vector<gusc::Threads::Message> messages;
+    bool isRefusing { false };
+};
+
+void testStrandFailures()
+{
+    // A refused drain discards the message and does not wedge the strand
+    {
+        RefusingExecutor executor;
+        gusc::Threads::Strand strand(executor);
+        auto payload = std::make_shared<int>(1);
+        std::size_t refusedCount { 0 };
+        executor.isRefusing = true;
+        for (int i = 0; i < 2; ++i)
+        {
+            try
+            {
+                strand.send([payload](){});
+            }
+            catch (const std::runtime_error&)
+            {
+                ++refusedCount;
+            }
+        }
+        expect(refusedCount == 2, "strand send throws while the executor refuses messages");
+        expect(payload.use_count() == 1, "message refused by the executor is released");
+        executor.isRefusing = false;
+        bool isCalled { false };
+        strand.send([&isCalled](){ isCalled = true; });
+        executor.run();
+        expect(isCalled, "strand recovers once the executor accepts messages again");
+    }
+    
+    // A drain refused from within the strand keeps the messages that were already sent successfully
+    {
+        constexpr std::size_t messageCount { 100 };
+        RefusingExecutor executor;
+        gusc::Threads::Strand strand(executor);
+        std::size_t executed { 0 };
+        for (std::size_t i = 0; i < messageCount; ++i)
+        {
+            strand.send([&executed](){ ++executed; });
+        }
+        executor.isRefusing = true;
+        const auto thrownCount = executor.run();
+        expect(thrownCount == 0 && executed > 0 && executed < messageCount, "refused drain continuation does not throw on the executor");
+        executor.isRefusing = false;
+        strand.send([&executed](){ ++executed; });
+        executor.run();
+        expect(executed == messageCount + 1, "messages kept after a refused drain are executed by the next drain");
+    }
+    
+    // A throwing message does not stop the strand
+    {
+        RefusingExecutor executor;
+        gusc::Threads::Strand strand(executor);
+        bool isCalled { false };
+        strand.send([](){ throw std::runtime_error("failure"); });
+        strand.send([&isCalled](){ isCalled = true; });
+        const auto thrownCount = executor.run();
+        expect(thrownCount == 1 && isCalled, "strand keeps executing messages after one throws");
+        expect(!strand.isCurrent(), "strand is not current after a message threw");
+        strand.send([&isCalled](){ isCalled = false; });
+        executor.run();
+        expect(!isCalled, "strand schedules new messages after one threw");
+    }
+    
+    // Stopped thread pool
+    {
+        gusc::Threads::ThreadPool pool(1);
+        pool.start();
+        pool.stop();
+        pool.join();
+        gusc::Threads::Strand strand(pool);
+        bool isThrown { false };
+        try
+        {
+            strand.send([](){});
+        }
+        catch (const std::runtime_error&)
+        {
+            isThrown = true;
+        }
+        expect(isThrown, "strand send throws if the executor has been stopped");
+    }
+}
+
+void testIdleStrategy(gusc::Threads::IdleStrategy strategy, const std::string& name)
+{
+    constexpr std::size_t messageCount { 1000 };
+    gusc::Threads::Thread worker(strategy);
+    std::size_t received { 0 };
+    std::promise<void> done;
+    worker.start();
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        worker.send([&](){
+            if (++received == messageCount)
+            {
+                done.set_value();
+            }
+        });
+        if (i % 100 == 0)
+        {
+            // Give the run-loop a chance to go idle between bursts
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    expect(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, name + " idle strategy processes all messages");
+    worker.stop();
+    worker.join();
+    tlog << name + " idle strategy received: " + std::to_string(received);
+}
+
+void testIdleThread(gusc::Threads::IdleStrategy strategy)
+{
+    gusc::Threads::Thread idle(strategy);
+    idle.start();
+    
+    // Let the run-loop spin down and park
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto cpuStart = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto cpuUsed = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    expect(cpuUsed < 0.05, "parked thread does not consume CPU while idle");
+    
+    std::promise<std::thread::id> woken;
+    auto future = woken.get_future();
+    idle.send([&woken](){
+        woken.set_value(std::this_thread::get_id());
+    });
+    expect(future.wait_for(std::chrono::seconds(1)) == std::future_status::ready, "parked thread wakes up on send");
+    idle.stop();
+    idle.join();
+    tlog << "Idle thread CPU time: " + std::to_string(cpuUsed) + "s";
+}
+
+void testTimerWheel()
+{
+    using Clock = gusc::Threads::TimerWheel::Clock;
+    constexpr std::size_t timerCount { 20000 };
+    const Clock::time_point origin = std::chrono::floor<std::chrono::microseconds>(Clock::now());
+    gusc::Threads::TimerWheel wheel(origin);
+    std::vector<gusc::Threads::TimerNode*> removed;
+    std::mt19937_64 random(42);
+    // Deadlines from a microsecond to a couple of weeks away, to exercise all the levels and the cascading
+    for (std::size_t i = 0; i < timerCount; ++i)
+    {
+        const auto range = std::uint64_t(1) << (random() % 41);
+        auto* node = new gusc::Threads::TimerNode();
+        node->deadline = origin + std::chrono::microseconds(random() % range + 1);
+        wheel.add(node);
+        // Remove every third timer, so that slot heads as well as inner slot nodes get unlinked
+        if (i % 3 == 0)
+        {
+            removed.push_back(node);
+        }
+    }
+    std::size_t removedCount { 0 };
+    for (auto* node : removed)
+    {
+        if (wheel.remove(node))
+        {
+            ++removedCount;
+        }
+        gusc::Threads::TimerNode::release(node);
+    }
+    expect(removedCount == removed.size() && wheel.getSize() == timerCount - removedCount, "timers are removed from the timer wheel");
+    std::size_t expiredCount { 0 };
+    std::size_t earlyCount { 0 };
+    std::size_t lateCount { 0 };
+    std::size_t outOfOrder { 0 };
+    std::size_t stalls { 0 };
+    Clock::time_point previous = origin;
+    while (!wheel.isEmpty())
+    {
+        const auto next = wheel.getNextDeadline();
+        if (next <= previous)
+        {
+            ++stalls;
+            break;
+        }
+        // Mostly jump straight to the next deadline, but sometimes stop short of it
+        auto now = next;
+        if (random() % 4 == 0)
+        {
+            now = previous + (next - previous) / 2;
+        }
+        auto& expired = wheel.advance(now);
+        for (std::size_t i = 0; i < expired.size(); ++i)
+        {
+            auto* node = expired[i];
+            if (node->deadline > now)
+            {
+                ++earlyCount;
+            }
+            // The next deadline is a lower bound, so every timer must expire on the first advance past it's deadline
+            if (node->deadline <= previous)
+            {
+                ++lateCount;
+            }
+            if (i && expired[i - 1]->deadline > node->deadline)
+            {
+                ++outOfOrder;
+            }
+        }
+        for (auto* node : expired)
+        {
+            gusc::Threads::TimerNode::release(node);
+        }
+        expiredCount += expired.size();
+        expired.clear();
+        previous = now;
+    }
+    expect(stalls == 0, "timer wheel next deadline is always in the future");
+    expect(expiredCount == timerCount - removedCount, "timer wheel expires all the timers that were not removed");
+    expect(earlyCount == 0, "timer wheel never expires timers early");
+    expect(lateCount == 0, "timer wheel expires timers on the first advance past their deadline");
+    expect(outOfOrder == 0, "timer wheel expires timers in deadline order");
+}
+
+void testTimers()
+{
+    using Clock = std::chrono::steady_clock;
+    gusc::Threads::Thread worker(gusc::Threads::IdleStrategy::Park);
+    worker.start();
+    
+    // One-shot timers fire in deadline order and never early
+    std::vector<int> order;
+    std::size_t earlyCount { 0 };
+    std::promise<void> ordered;
+    const auto start = Clock::now();
+    for (const int delay : { 30, 10, 20 })
+    {
+        worker.sendAfter(std::chrono::milliseconds(delay), [&, delay](){
+            if (Clock::now() - start < std::chrono::milliseconds(delay))
+            {
+                ++earlyCount;
+            }
+            order.push_back(delay);
+            if (order.size() == 3)
+            {
+                ordered.set_value();
+            }
+        });
+    }
+    // Cancelled timers never fire
+    bool cancelledFired { false };
+    auto cancelled = worker.sendAfter(std::chrono::milliseconds(5), [&](){
+        cancelledFired = true;
+    });
+    cancelled.cancel();
+    expect(ordered.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, "parked thread wakes up for timers");
+    expect(order == std::vector<int>({ 10, 20, 30 }), "timers fire in deadline order");
+    expect(earlyCount == 0, "timers never fire before their deadline");
+    expect(cancelled.getIsCancelled(), "timer handle reports cancellation");
+    
+    // Periodic timers fire until cancelled
+    std::atomic<std::size_t> ticks { 0 };
+    std::promise<void> ticked;
+    auto periodic = worker.sendEvery(std::chrono::milliseconds(2), [&](){
+        if (++ticks == 5)
+        {
+            ticked.set_value();
+        }
+    });
+    expect(ticked.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, "periodic timer fires repeatedly");
+    periodic.cancel();
+    // Synchronize with the run-loop, a call might have been in flight while cancelling
+    std::promise<void> flushed;
+    worker.send([&](){ flushed.set_value(); });
+    flushed.get_future().wait();
+    const auto ticksAtCancel = ticks.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    expect(ticks == ticksAtCancel, "cancelled periodic timer stops firing");
+    
+    // Cancelled timers release their callable without waiting for the deadline
+    auto capture = std::make_shared<int>(1);
+    auto distant = worker.sendAfter(std::chrono::hours(1), [capture](){});
+    expect(capture.use_count() == 2, "scheduled timer holds its callable");
+    distant.cancel();
+    const auto releaseDeadline = Clock::now() + std::chrono::seconds(5);
+    while (capture.use_count() != 1 && Clock::now() < releaseDeadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    expect(capture.use_count() == 1, "cancelled timer releases its callable before the deadline");
+    
+    // Lots of timers from several producers
+    constexpr std::size_t producerCount { 4 };
+    constexpr std::size_t timerCount { 25000 };
+    std::atomic<std::size_t> fired { 0 };
+    std::atomic<std::size_t> firedEarly { 0 };
+    std::promise<void> allFired;
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&, p](){
+            std::mt19937 random(static_cast<unsigned>(p));
+            for (std::size_t i = 0; i < timerCount; ++i)
+            {
+                const auto deadline = Clock::now() + std::chrono::microseconds(random() % 100000);
+                worker.sendAt(deadline, [&, deadline](){
+                    if (Clock::now() < deadline)
+                    {
+                        ++firedEarly;
+                    }
+                    if (++fired == producerCount * timerCount)
+                    {
+                        allFired.set_value();
+                    }
+                });
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    expect(allFired.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready, "thread fires all the timers");
+    expect(firedEarly == 0, "timers from many producers never fire early");
+    
+    // Timers that have not fired are dropped when the thread stops
+    bool pendingFired { false };
+    worker.sendAfter(std::chrono::hours(1), [&](){
+        pendingFired = true;
+    });
+    worker.stop();
+    worker.join();
+    expect(!pendingFired, "pending timers are not executed after stop");
+    
+    // Timers fire in between message batches of a thread that never runs out of messages
+    gusc::Threads::Thread busy;
+    busy.setDrainTimeout(std::chrono::milliseconds(10));
+    std::function<void()> chain = [&](){
+        busy.send([&chain](){ chain(); });
+    };
+    std::promise<void> busyFired;
+    busy.send([&chain](){ chain(); });
+    busy.sendAfter(std::chrono::milliseconds(5), [&](){
+        busyFired.set_value();
+    });
+    busy.start();
+    expect(busyFired.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready, "timer fires on a thread that is never out of messages");
+    busy.stop();
+    busy.join();
+    tlog << "Timers fired: " + std::to_string(fired.load());
+}
+
+/// @brief executor that destroys every message without running it
+class DroppingExecutor : public gusc::Threads::Executor
+{
+public:
+    bool isCurrent() const noexcept override
+    {
+        return false;
+    }
+    void post(gusc::Threads::Message&&) override
+    {}
+};
+
+void testInvoke()
+{
+    gusc::Threads::Thread worker;
+    worker.start();
+    
+    auto value = worker.invoke([](){
+        return std::this_thread::get_id();
+    });
+    expect(worker == value.get(), "invoke returns the result from the target thread");
+    expect(!value.getIsValid(), "future is not valid after get");
+    
+    auto moveOnly = worker.invoke([](){
+        return std::make_unique<int>(42);
+    });
+    expect(*moveOnly.get() == 42, "invoke returns move-only results");
+    
+    bool isCalled { false };
+    auto done = worker.invoke([&](){
+        isCalled = true;
+    });
+    done.get();
+    expect(isCalled, "invoke runs void callables");
+    
+    auto failed = worker.invoke([]() -> int {
+        throw std::runtime_error("failure");
+    });
+    bool isThrown { false };
+    try
+    {
+        failed.get();
+    }
+    catch (const std::runtime_error&)
+    {
+        isThrown = true;
+    }
+    expect(isThrown, "invoke rethrows the exception from the target thread");
+    
+    // Invoking on the target thread itself runs inline instead of deadlocking on the result
+    auto nested = worker.invoke([&worker](){
+        auto inner = worker.invoke([](){
+            return 1;
+        });
+        const bool isReady = inner.getIsReady();
+        return isReady && inner.get() == 1;
+    });
+    expect(nested.waitFor(std::chrono::seconds(5)) && nested.get(), "invoke on the target thread runs inline");
+    
+    worker.stop();
+    worker.join();
+    
+    // Invoking on a thread that has not been started queues the callable, even though the thread counts as current
+    gusc::Threads::Thread unstarted;
+    auto queued = unstarted.invoke([](){
+        return std::this_thread::get_id();
+    });
+    expect(unstarted.isCurrent() && !queued.getIsReady(), "invoke on an unstarted thread queues the callable");
+    unstarted.start();
+    expect(queued.waitFor(std::chrono::seconds(5)) && unstarted == queued.get(), "queued invoke runs once the thread starts");
+    unstarted.stop();
+    unstarted.join();
+    
+    // Messages that are never executed break the promise
+    DroppingExecutor dropping;
+    auto dropped = dropping.invoke([](){
+        return 1;
+    });
+    bool isBroken { false };
+    try
+    {
+        dropped.get();
+    }
+    catch (const std::runtime_error&)
+    {
+        isBroken = true;
+    }
+    expect(isBroken, "future of a dropped message throws");
+}
+
+void testPriorityOrder()
+{
+    using gusc::Threads::Priority;
+    gusc::Threads::Thread worker;
+    std::vector<int> order;
+    worker.send([&](){ order.push_back(3); }, Priority::Low);
+    worker.send([&](){ order.push_back(2); });
+    worker.send([&](){ order.push_back(1); }, Priority::High);
+    worker.send([&](){ order.push_back(4); }, Priority::Low);
+    worker.start();
+    worker.invoke([](){}, Priority::Low).get();
+    expect(order == std::vector<int>({ 1, 2, 3, 4 }), "messages are executed in priority order and FIFO within a lane");
+    
+    // A chain of high priority messages must not starve the lower lanes
+    std::atomic<bool> isLowDone { false };
+    std::size_t chainLength { 0 };
+    std::promise<void> chainDone;
+    std::function<void()> chain = [&](){
+        ++chainLength;
+        if (isLowDone || chainLength > 100000)
+        {
+            chainDone.set_value();
+            return;
+        }
+        worker.send([&](){ chain(); }, Priority::High);
+    };
+    worker.send([&](){
+        worker.send([&](){ isLowDone = true; }, Priority::Low);
+        chain();
+    }, Priority::High);
+    chainDone.get_future().wait();
+    expect(isLowDone, "low priority messages are not starved by high priority ones");
+    expect(chainLength < 1000, "starved lanes are served within a bounded number of messages");
+    worker.stop();
+    worker.join();
+    tlog << "High priority messages before a starved one: " + std::to_string(chainLength);
+}
+
+/// @return 99th percentile latency of probe messages sent while the thread is busy with bulk messages
+std::chrono::microseconds measureProbeLatency(gusc::Threads::Priority probePriority)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t bulkCount { 10000 };
+    constexpr std::size_t probeCount { 20 };
+    gusc::Threads::Thread worker;
+    std::vector<Clock::duration> latencies;
+    latencies.reserve(probeCount);
+    for (std::size_t i = 0; i < bulkCount; ++i)
+    {
+        worker.send([](){
+            // A few microseconds of work
+            const auto until = Clock::now() + std::chrono::microseconds(5);
+            while (Clock::now() < until)
+            {}
+        }, gusc::Threads::Priority::Low);
+    }
+    worker.start();
+    for (std::size_t i = 0; i < probeCount; ++i)
+    {
+        const auto sent = Clock::now();
+        worker.send([&latencies, sent](){
+            latencies.push_back(Clock::now() - sent);
+        }, probePriority);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    worker.invoke([](){}, gusc::Threads::Priority::Low).get();
+    worker.stop();
+    worker.join();
+    std::sort(latencies.begin(), latencies.end());
+    return std::chrono::duration_cast<std::chrono::microseconds>(latencies[latencies.size() * 99 / 100]);
+}
+
+void testPriorityLatency()
+{
+    const auto highLatency = measureProbeLatency(gusc::Threads::Priority::High);
+    const auto lowLatency = measureProbeLatency(gusc::Threads::Priority::Low);
+    expect(highLatency * 4 < lowLatency, "high priority messages overtake bulk messages");
+    tlog << "Probe p99 latency under bulk load - high priority: " + std::to_string(highLatency.count()) + "us, same priority: " + std::to_string(lowLatency.count()) + "us";
+}
+
+void testDeadlines()
+{
+    using gusc::Threads::Priority;
+    using Clock = std::chrono::steady_clock;
+    const auto now = Clock::now();
+    gusc::Threads::Thread worker;
+    std::vector<int> order;
+    worker.sendBefore(now + std::chrono::seconds(30), [&](){ order.push_back(4); });
+    worker.send([&](){ order.push_back(5); });
+    worker.sendBefore(now + std::chrono::seconds(10), [&](){ order.push_back(2); });
+    worker.sendBefore(now + std::chrono::seconds(20), [&](){ order.push_back(3); });
+    worker.send([&](){ order.push_back(1); }, Priority::High);
+    worker.sendBefore(now - std::chrono::milliseconds(10), [](){});
+    worker.start();
+    worker.invoke([](){}, Priority::Low).get();
+    expect(order == std::vector<int>({ 1, 2, 3, 4, 5 }), "deadline messages are executed earliest deadline first after the high priority lane");
+    const auto counters = worker.getDeadlineCounters();
+    expect(counters.executedCount == 4, "executed deadline messages are counted");
+    expect(counters.missedCount == 1 && counters.maxLateness >= std::chrono::milliseconds(10), "messages executed past their deadline are counted");
+    
+    // A stream of deadline messages must not starve the normal lane
+    std::atomic<bool> isNormalDone { false };
+    std::size_t chainLength { 0 };
+    std::promise<void> chainDone;
+    std::function<void()> chain = [&](){
+        ++chainLength;
+        if (isNormalDone || chainLength > 100000)
+        {
+            chainDone.set_value();
+            return;
+        }
+        worker.sendBefore(Clock::now(), [&](){ chain(); });
+    };
+    worker.sendBefore(Clock::now(), [&](){
+        worker.send([&](){ isNormalDone = true; });
+        chain();
+    });
+    chainDone.get_future().wait();
+    expect(isNormalDone && chainLength < 1000, "normal priority messages are not starved by deadline messages");
+    
+    // A stream of high priority messages must not starve the deadline heap
+    std::atomic<bool> isDeadlineDone { false };
+    std::size_t highChainLength { 0 };
+    std::promise<void> highChainDone;
+    std::function<void()> highChain = [&](){
+        ++highChainLength;
+        if (isDeadlineDone || highChainLength > 100000)
+        {
+            highChainDone.set_value();
+            return;
+        }
+        worker.send([&](){ highChain(); }, Priority::High);
+    };
+    worker.send([&](){
+        worker.sendBefore(Clock::now() + std::chrono::hours(1), [&](){ isDeadlineDone = true; });
+        highChain();
+    }, Priority::High);
+    highChainDone.get_future().wait();
+    expect(isDeadlineDone && highChainLength < 1000, "deadline messages are not starved by high priority messages");
+    worker.stop();
+    worker.join();
+    
+    // Messages left on a thread that never ran are released
+    gusc::Threads::Thread idle;
+    idle.sendBefore(now, [payload = std::make_unique<int>(1)](){});
+    
+    // Bounded threads refuse deadline messages instead of bypassing the queue capacity
+    gusc::Threads::Thread bounded(4, gusc::Threads::OverflowPolicy::Fail);
+    bool isRefused { false };
+    try
+    {
+        bounded.sendBefore(now, [](){});
+    }
+    catch (const std::runtime_error&)
+    {
+        isRefused = true;
+    }
+    expect(isRefused, "bounded thread refuses deadline messages");
+    tlog << "Deadline messages executed: " + std::to_string(worker.getDeadlineCounters().executedCount) + ", missed: " + std::to_string(worker.getDeadlineCounters().missedCount);
+}
+
 void runThreadTests()
 {
     tlog << "Thread Tests";
@@ -123,4 +1223,24 @@ void runThreadTests()
     t1.start();
     t2.start();
     mt.start();
+    
+    testMultipleProducers();
+    testMoveOnlyMessages();
+    testSendBatch();
+    testBoundedThread();
+    testLeftovers();
+    testThreadPool();
+    testStrands();
+    testStrandFailures();
+    testTimerWheel();
+    testTimers();
+    testInvoke();
+    testPriorityOrder();
+    testPriorityLatency();
+    testDeadlines();
+    testIdleThread(gusc::Threads::IdleStrategy::SpinThenPark);
+    testIdleThread(gusc::Threads::IdleStrategy::Park);
+    testIdleStrategy(gusc::Threads::IdleStrategy::BusySpin, "Busy spin");
+    testIdleStrategy(gusc::Threads::IdleStrategy::SpinThenPark, "Spin then park");
+    testIdleStrategy(gusc::Threads::IdleStrategy::Park, "Park");
 }
@@ -16,6 +16,21 @@
 #include <vector>
 #include <thread>
 
+inline std::size_t& failedExpectations() noexcept
+{
+    static std::size_t count { 0 };
+    return count;
+}
+
+inline void expect(bool condition, const std::string& description)
+{
+    if (!condition)
+    {
+        ++failedExpectations();
+        std::cerr << "FAILED: " << description << std::endl;
+    }
+}
+
 inline std::string tidToStr(const std::thread::id& id)
 {
     std::ostringstream ss;
@@ -6,11 +6,14 @@
 //  Copyright © 2020 Gusts Kaksis. All rights reserved.
 //
 
+#include "MessageTests.hpp"
 #include "ThreadTests.hpp"
 #include "SignalTests.hpp"
+#include "Utilities.hpp"
 
 int main(int argc, const char * argv[]) {
+    runMessageTests();
     runThreadTests();
     runSignalTests();
-    return 0;
+    return failedExpectations() ? 1 : 0;
 }
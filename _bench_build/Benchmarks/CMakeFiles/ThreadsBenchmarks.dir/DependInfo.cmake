@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Benchmarks/SignalBenchmarks.cpp" "Benchmarks/CMakeFiles/ThreadsBenchmarks.dir/SignalBenchmarks.cpp.o" "gcc" "Benchmarks/CMakeFiles/ThreadsBenchmarks.dir/SignalBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/ThreadBenchmarks.cpp" "Benchmarks/CMakeFiles/ThreadsBenchmarks.dir/ThreadBenchmarks.cpp.o" "gcc" "Benchmarks/CMakeFiles/ThreadsBenchmarks.dir/ThreadBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/main.cpp" "Benchmarks/CMakeFiles/ThreadsBenchmarks.dir/main.cpp.o" "gcc" "Benchmarks/CMakeFiles/ThreadsBenchmarks.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
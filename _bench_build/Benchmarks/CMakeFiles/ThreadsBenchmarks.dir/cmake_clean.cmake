@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ThreadsBenchmarks.dir/SignalBenchmarks.cpp.o"
+  "CMakeFiles/ThreadsBenchmarks.dir/SignalBenchmarks.cpp.o.d"
+  "CMakeFiles/ThreadsBenchmarks.dir/ThreadBenchmarks.cpp.o"
+  "CMakeFiles/ThreadsBenchmarks.dir/ThreadBenchmarks.cpp.o.d"
+  "CMakeFiles/ThreadsBenchmarks.dir/main.cpp.o"
+  "CMakeFiles/ThreadsBenchmarks.dir/main.cpp.o.d"
+  "ThreadsBenchmarks"
+  "ThreadsBenchmarks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ThreadsBenchmarks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/Tests
+# Build directory: /root/repo/_bench_build/Tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ThreadsTests "/root/repo/_bench_build/Tests/ThreadsTests")
+set_tests_properties(ThreadsTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/Tests/CMakeLists.txt;19;add_test;/root/repo/Tests/CMakeLists.txt;0;")
+add_test(ThreadsCoroutineTests "/root/repo/_bench_build/Tests/ThreadsCoroutineTests")
+set_tests_properties(ThreadsCoroutineTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/Tests/CMakeLists.txt;32;add_test;/root/repo/Tests/CMakeLists.txt;0;")
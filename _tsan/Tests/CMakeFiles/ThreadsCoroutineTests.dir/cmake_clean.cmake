@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ThreadsCoroutineTests.dir/CoroutineMain.cpp.o"
+  "CMakeFiles/ThreadsCoroutineTests.dir/CoroutineMain.cpp.o.d"
+  "CMakeFiles/ThreadsCoroutineTests.dir/CoroutineTests.cpp.o"
+  "CMakeFiles/ThreadsCoroutineTests.dir/CoroutineTests.cpp.o.d"
+  "ThreadsCoroutineTests"
+  "ThreadsCoroutineTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ThreadsCoroutineTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Tests/MessageTests.cpp" "Tests/CMakeFiles/ThreadsTests.dir/MessageTests.cpp.o" "gcc" "Tests/CMakeFiles/ThreadsTests.dir/MessageTests.cpp.o.d"
+  "/root/repo/Tests/SignalTests.cpp" "Tests/CMakeFiles/ThreadsTests.dir/SignalTests.cpp.o" "gcc" "Tests/CMakeFiles/ThreadsTests.dir/SignalTests.cpp.o.d"
+  "/root/repo/Tests/ThreadTests.cpp" "Tests/CMakeFiles/ThreadsTests.dir/ThreadTests.cpp.o" "gcc" "Tests/CMakeFiles/ThreadsTests.dir/ThreadTests.cpp.o.d"
+  "/root/repo/Tests/main.cpp" "Tests/CMakeFiles/ThreadsTests.dir/main.cpp.o" "gcc" "Tests/CMakeFiles/ThreadsTests.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ThreadsTests.dir/MessageTests.cpp.o"
+  "CMakeFiles/ThreadsTests.dir/MessageTests.cpp.o.d"
+  "CMakeFiles/ThreadsTests.dir/SignalTests.cpp.o"
+  "CMakeFiles/ThreadsTests.dir/SignalTests.cpp.o.d"
+  "CMakeFiles/ThreadsTests.dir/ThreadTests.cpp.o"
+  "CMakeFiles/ThreadsTests.dir/ThreadTests.cpp.o.d"
+  "CMakeFiles/ThreadsTests.dir/main.cpp.o"
+  "CMakeFiles/ThreadsTests.dir/main.cpp.o.d"
+  "ThreadsTests"
+  "ThreadsTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ThreadsTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,218 @@
+//
+//  Coroutines.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef Coroutines_hpp
+#define Coroutines_hpp
+
+#if __cplusplus < 202002L && (!defined(_MSVC_LANG) || _MSVC_LANG < 202002L)
+#error "Coroutines.hpp requires C++20"
+#endif
+
+#include "Message.hpp"
+#include "Signal.hpp"
+#include "Thread.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+
+namespace gusc::Threads
+{
+
+/// @brief message that resumes a suspended coroutine - the handle is stored inline, so queuing it never allocates
+/// @note if the message is destroyed without being executed (the executor stopped) the coroutine stays suspended
+class ResumeMessage
+{
+public:
+    explicit ResumeMessage(std::coroutine_handle<> initHandle) noexcept
+        : handle(initHandle)
+    {}
+
+    inline void operator()() const
+    {
+        handle.resume();
+    }
+
+private:
+    std::coroutine_handle<> handle;
+};
+
+static_assert(Message::isInline<ResumeMessage>(), "Resuming a coroutine must not allocate");
+
+/// @brief fire-and-forget coroutine - starts running right away and destroys itself when it finishes
+/// @note an exception escaping the coroutine terminates the program
+class Task
+{
+public:
+    struct promise_type
+    {
+        inline Task get_return_object() const noexcept
+        {
+            return {};
+        }
+        inline std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+        inline std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+        inline void return_void() const noexcept
+        {}
+        inline void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/// @brief awaitable that resumes the coroutine on an executor
+class ScheduleAwaitable
+{
+public:
+    explicit ScheduleAwaitable(Executor& initExecutor) noexcept
+        : executor(initExecutor)
+    {}
+
+    /// @brief don't suspend at all if the coroutine is already running on the executor
+    inline bool await_ready() const noexcept
+    {
+        return executor.getIsExecuting();
+    }
+
+    inline void await_suspend(std::coroutine_handle<> handle)
+    {
+        executor.post(Message(ResumeMessage(handle)));
+    }
+
+    inline void await_resume() const noexcept
+    {}
+
+private:
+    Executor& executor;
+};
+
+/// @brief resume the coroutine on an executor - co_await schedule(thread)
+inline ScheduleAwaitable schedule(Executor& executor) noexcept
+{
+    return ScheduleAwaitable(executor);
+}
+
+/// @brief result of awaiting a signal emission - nothing, the single argument or a tuple of all the arguments
+template<typename ...TArg>
+struct SignalAwaitResult
+{
+    using Type = std::tuple<TArg...>;
+};
+
+template<>
+struct SignalAwaitResult<>
+{
+    using Type = void;
+};
+
+template<typename TArg>
+struct SignalAwaitResult<TArg>
+{
+    using Type = TArg;
+};
+
+/// @brief awaitable that resumes the coroutine on an executor with the arguments of the next signal emission
+template<typename ...TArg>
+class SignalAwaitable
+{
+public:
+    using Result = typename SignalAwaitResult<TArg...>::Type;
+
+    SignalAwaitable(Signal<TArg...>& initSignal, Executor& initExecutor)
+        : signal(initSignal)
+        , executor(initExecutor)
+        , state(std::make_shared<State>())
+    {}
+
+    inline bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // The coroutine can be resumed (and this awaitable destroyed) before connect() returns, so only locals are used from here on
+        auto currentState = state;
+        auto& currentSignal = signal;
+        currentState->handle = handle;
+        const auto id = currentSignal.connect(&executor, [currentState, &currentSignal](const TArg&... args){
+            if (currentState->isFired.exchange(true, std::memory_order_acq_rel))
+            {
+                return;
+            }
+            currentState->values.emplace(args...);
+            currentState->finish(currentSignal);
+            currentState->handle.resume();
+        }, ConnectionType::Queued);
+        currentState->connectionId.store(id, std::memory_order_release);
+        currentState->finish(currentSignal);
+    }
+
+    Result await_resume()
+    {
+        if constexpr (sizeof...(TArg) == 1)
+        {
+            return std::get<0>(std::move(*state->values));
+        }
+        else if constexpr (sizeof...(TArg) > 1)
+        {
+            return std::move(*state->values);
+        }
+    }
+
+private:
+    struct State
+    {
+        std::coroutine_handle<> handle;
+        std::optional<std::tuple<TArg...>> values;
+        std::atomic<bool> isFired { false };
+        std::atomic<std::size_t> connectionId { 0 };
+        /// @brief connect() returning and the first delivery - whichever comes last disconnects the one-shot slot
+        std::atomic<std::size_t> pendingSteps { 2 };
+
+        inline void finish(Signal<TArg...>& fromSignal)
+        {
+            if (pendingSteps.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                fromSignal.disconnect(connectionId.load(std::memory_order_acquire));
+            }
+        }
+    };
+
+    Signal<TArg...>& signal;
+    Executor& executor;
+    std::shared_ptr<State> state;
+};
+
+/// @brief wait for the next signal emission and resume on an executor - co_await next(signal, thread)
+/// @note the signal must outlive the suspended coroutine
+template<typename ...TArg>
+inline SignalAwaitable<TArg...> next(Signal<TArg...>& signal, Executor& executor)
+{
+    return SignalAwaitable<TArg...>(signal, executor);
+}
+
+/// @brief wait for the next emission of a signal without arguments and resume on an executor
+inline SignalAwaitable<> next(Signal<void>& signal, Executor& executor)
+{
+    return SignalAwaitable<>(signal, executor);
+}
+
+}
+
+#endif /* Coroutines_hpp */
@@ -0,0 +1,239 @@
+//
+//  Delegate.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef Delegate_hpp
+#define Delegate_hpp
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gusc::Threads
+{
+
+template<typename TSignature>
+class Delegate;
+
+/// @brief copyable type-erased callable object with inline (small buffer) storage - a lightweight replacement for std::function
+/// @note function pointers, object and member function pointer pairs and small lambdas are stored inline, trivially copyable ones are copied without any indirection
+/// @note callables that don't fit in the inline storage (or can throw on move) are stored on the heap
+template<typename TReturn, typename ...TArg>
+class Delegate<TReturn(TArg...)>
+{
+public:
+    /// @brief size of the inline storage in bytes (fits an object pointer and a member function pointer)
+    static constexpr std::size_t InlineSize { 4 * sizeof(void*) };
+
+    /// @brief check if a callable type will be stored inline without heap allocation
+    template<typename TCallable>
+    static constexpr bool isInline() noexcept
+    {
+        return sizeof(TCallable) <= InlineSize
+            && alignof(TCallable) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible<TCallable>::value;
+    }
+
+    Delegate() = default;
+    template<typename TCallable, typename = std::enable_if_t<!std::is_same<std::decay_t<TCallable>, Delegate>::value && std::is_invocable_r<TReturn, std::decay_t<TCallable>&, TArg...>::value>>
+    Delegate(TCallable&& initCallable)
+    {
+        emplace(std::forward<TCallable>(initCallable));
+    }
+    /// @brief create a delegate that calls a member function on an object
+    template<typename TClass, typename TMethod, typename = std::enable_if_t<std::is_member_function_pointer<TMethod>::value>>
+    Delegate(TClass* object, TMethod method)
+    {
+        emplace(MethodCall<TClass, TMethod>{object, method});
+    }
+    Delegate(const Delegate& other)
+    {
+        copyFrom(other);
+    }
+    Delegate& operator=(const Delegate& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+    Delegate(Delegate&& other) noexcept
+    {
+        moveFrom(other);
+    }
+    Delegate& operator=(Delegate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+    ~Delegate()
+    {
+        reset();
+    }
+
+    /// @brief destroy the stored callable object
+    inline void reset() noexcept
+    {
+        if (manager)
+        {
+            manager(Operation::Destroy, nullptr, &storage);
+            manager = nullptr;
+        }
+        invoker = nullptr;
+    }
+
+    /// @brief call the stored callable object
+    inline TReturn operator()(TArg... args) const
+    {
+        return invoker(const_cast<void*>(static_cast<const void*>(&storage)), std::forward<TArg>(args)...);
+    }
+
+    inline explicit operator bool() const noexcept
+    {
+        return invoker != nullptr;
+    }
+
+private:
+    enum class Operation
+    {
+        Copy,
+        Move,
+        Destroy
+    };
+
+    using Invoker = TReturn(*)(void*, TArg...);
+    /// @brief copies, moves or destroys the callable (null for trivially copyable inline callables)
+    using Manager = void(*)(Operation, void* to, void* from);
+
+    template<typename TClass, typename TMethod>
+    struct MethodCall
+    {
+        inline TReturn operator()(TArg... args) const
+        {
+            return (object->*method)(std::forward<TArg>(args)...);
+        }
+        TClass* object;
+        TMethod method;
+    };
+
+    template<typename TCallable>
+    struct InlineCallable
+    {
+        static TReturn invoke(void* data, TArg... args)
+        {
+            return (*static_cast<TCallable*>(data))(std::forward<TArg>(args)...);
+        }
+        static void manage(Operation operation, void* to, void* from)
+        {
+            auto* source = static_cast<TCallable*>(from);
+            switch (operation)
+            {
+                case Operation::Copy:
+                    new (to) TCallable(*source);
+                    break;
+                case Operation::Move:
+                    new (to) TCallable(std::move(*source));
+                    source->~TCallable();
+                    break;
+                case Operation::Destroy:
+                    source->~TCallable();
+                    break;
+            }
+        }
+    };
+
+    template<typename TCallable>
+    struct HeapCallable
+    {
+        static TReturn invoke(void* data, TArg... args)
+        {
+            return (**static_cast<TCallable**>(data))(std::forward<TArg>(args)...);
+        }
+        static void manage(Operation operation, void* to, void* from)
+        {
+            auto* source = *static_cast<TCallable**>(from);
+            switch (operation)
+            {
+                case Operation::Copy:
+                    new (to) TCallable*(new TCallable(*source));
+                    break;
+                case Operation::Move:
+                    new (to) TCallable*(source);
+                    break;
+                case Operation::Destroy:
+                    delete source;
+                    break;
+            }
+        }
+    };
+
+    template<typename TCallable>
+    void emplace(TCallable&& newCallable)
+    {
+        using TStored = std::decay_t<TCallable>;
+        if constexpr (isInline<TStored>())
+        {
+            new (&storage) TStored(std::forward<TCallable>(newCallable));
+            if constexpr (!std::is_trivially_copyable<TStored>::value)
+            {
+                manager = &InlineCallable<TStored>::manage;
+            }
+            invoker = &InlineCallable<TStored>::invoke;
+        }
+        else
+        {
+            new (&storage) TStored*(new TStored(std::forward<TCallable>(newCallable)));
+            manager = &HeapCallable<TStored>::manage;
+            invoker = &HeapCallable<TStored>::invoke;
+        }
+    }
+
+    inline void copyFrom(const Delegate& other)
+    {
+        if (other.manager)
+        {
+            other.manager(Operation::Copy, &storage, const_cast<void*>(static_cast<const void*>(&other.storage)));
+            manager = other.manager;
+        }
+        else
+        {
+            std::memcpy(&storage, &other.storage, InlineSize);
+        }
+        invoker = other.invoker;
+    }
+
+    inline void moveFrom(Delegate& other) noexcept
+    {
+        if (other.manager)
+        {
+            other.manager(Operation::Move, &storage, &other.storage);
+            manager = other.manager;
+            other.manager = nullptr;
+        }
+        else
+        {
+            std::memcpy(&storage, &other.storage, InlineSize);
+        }
+        invoker = other.invoker;
+        other.invoker = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char storage[InlineSize];
+    Invoker invoker { nullptr };
+    Manager manager { nullptr };
+};
+
+}
+
+#endif /* Delegate_hpp */
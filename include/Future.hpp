@@ -0,0 +1,349 @@
+//
+//  Future.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef Future_hpp
+#define Future_hpp
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace gusc::Threads
+{
+
+template<typename T>
+class Future;
+template<typename T>
+class Promise;
+
+/// @brief shared state of a promise and it's future - a single allocation holding the result
+/// @note completing never locks unless somebody is already blocked waiting for the result
+template<typename T>
+class FutureState
+{
+public:
+    /// @brief stored value type (void results store an empty tag)
+    struct Void {};
+    using Value = std::conditional_t<std::is_void<T>::value, Void, T>;
+
+    FutureState(const FutureState&) = delete;
+    FutureState& operator=(const FutureState&) = delete;
+    FutureState(FutureState&&) = delete;
+    FutureState& operator=(FutureState&&) = delete;
+
+    inline bool getIsReady() const noexcept
+    {
+        return isReady.load(std::memory_order_acquire);
+    }
+
+    /// @brief block until the result is available
+    void wait()
+    {
+        // Round trips are usually short, give the other thread a chance to finish before blocking
+        for (std::size_t i = 0; i < MaxSpinCycles; ++i)
+        {
+            if (getIsReady())
+            {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(waitMutex);
+        isWaiting.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in complete() - either we see the result or the completing thread sees us waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!getIsReady())
+        {
+            waitCondition.wait(lock);
+        }
+    }
+
+    /// @brief block until the result is available or the deadline passes
+    /// @return false if the result is not available yet
+    template<typename TClock, typename TDuration>
+    bool waitUntil(const std::chrono::time_point<TClock, TDuration>& deadline)
+    {
+        if (getIsReady())
+        {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(waitMutex);
+        isWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!getIsReady())
+        {
+            if (waitCondition.wait_until(lock, deadline) == std::cv_status::timeout)
+            {
+                return getIsReady();
+            }
+        }
+        return true;
+    }
+
+private:
+    friend class Promise<T>;
+    template<typename TValue>
+    friend class Future;
+
+    static constexpr std::size_t MaxSpinCycles { 100 };
+
+    FutureState() = default;
+
+    template<typename ...TArg>
+    void setValue(TArg&&... args)
+    {
+        value.emplace(std::forward<TArg>(args)...);
+        complete();
+    }
+
+    void setException(std::exception_ptr newException)
+    {
+        exception = std::move(newException);
+        complete();
+    }
+
+    inline void complete()
+    {
+        isReady.store(true, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isWaiting.load(std::memory_order_relaxed))
+        {
+            // Synchronize with a waiter that is between checking the result and blocking, but notify without the lock so it does not wake up just to block on it
+            {
+                std::lock_guard<std::mutex> lock(waitMutex);
+            }
+            waitCondition.notify_all();
+        }
+    }
+
+    inline void acquire() noexcept
+    {
+        referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static inline void release(FutureState* state) noexcept
+    {
+        if (state && state->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete state;
+        }
+    }
+
+    std::atomic<bool> isReady { false };
+    std::atomic<bool> isWaiting { false };
+    std::atomic<std::size_t> referenceCount { 1 };
+    std::optional<Value> value;
+    std::exception_ptr exception;
+    std::mutex waitMutex;
+    std::condition_variable waitCondition;
+};
+
+/// @brief receiving end of a single result - a lightweight replacement for std::future
+template<typename T>
+class Future
+{
+public:
+    Future() = default;
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+    Future(Future&& other) noexcept
+        : state(std::exchange(other.state, nullptr))
+    {}
+    Future& operator=(Future&& other) noexcept
+    {
+        if (this != &other)
+        {
+            FutureState<T>::release(state);
+            state = std::exchange(other.state, nullptr);
+        }
+        return *this;
+    }
+    ~Future()
+    {
+        FutureState<T>::release(state);
+    }
+
+    /// @brief check if the future refers to a result (false after get() or for a default constructed future)
+    inline bool getIsValid() const noexcept
+    {
+        return state != nullptr;
+    }
+
+    /// @brief check if the result is available without blocking
+    inline bool getIsReady() const noexcept
+    {
+        return state && state->getIsReady();
+    }
+
+    /// @brief block until the result is available
+    void wait() const
+    {
+        getState()->wait();
+    }
+
+    /// @brief block until the result is available or the timeout expires
+    /// @return false if the result is not available yet
+    template<typename TRep, typename TPeriod>
+    bool waitFor(const std::chrono::duration<TRep, TPeriod>& timeout) const
+    {
+        return getState()->waitUntil(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// @brief wait for the result and take it, rethrows the exception if the callable threw
+    /// @note the future is no longer valid afterwards
+    T get()
+    {
+        FutureState<T>* const current = getState();
+        current->wait();
+        Future released(std::move(*this));
+        if (current->exception)
+        {
+            std::rethrow_exception(current->exception);
+        }
+        if constexpr (!std::is_void<T>::value)
+        {
+            return std::move(*current->value);
+        }
+    }
+
+private:
+    friend class Promise<T>;
+
+    /// @brief adopt a state reference
+    explicit Future(FutureState<T>* initState) noexcept
+        : state(initState)
+    {}
+
+    inline FutureState<T>* getState() const
+    {
+        if (!state)
+        {
+            throw std::runtime_error("Future has no result state");
+        }
+        return state;
+    }
+
+    FutureState<T>* state { nullptr };
+};
+
+/// @brief sending end of a single result
+/// @note destroying a promise without a result stores an exception in the future (the callable was never executed)
+template<typename T>
+class Promise
+{
+public:
+    Promise()
+        : state(new FutureState<T>())
+    {}
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+    Promise(Promise&& other) noexcept
+        : state(std::exchange(other.state, nullptr))
+        , isFutureRetrieved(other.isFutureRetrieved)
+    {}
+    Promise& operator=(Promise&& other) noexcept
+    {
+        if (this != &other)
+        {
+            abandon();
+            state = std::exchange(other.state, nullptr);
+            isFutureRetrieved = other.isFutureRetrieved;
+        }
+        return *this;
+    }
+    ~Promise()
+    {
+        abandon();
+    }
+
+    /// @brief get the future of this promise
+    /// @note can be called only once
+    Future<T> getFuture()
+    {
+        if (!state || isFutureRetrieved)
+        {
+            throw std::runtime_error("Future already retrieved");
+        }
+        isFutureRetrieved = true;
+        state->acquire();
+        return Future<T>(state);
+    }
+
+    /// @brief store the result and wake up the waiting thread
+    template<typename ...TArg>
+    void setValue(TArg&&... args)
+    {
+        getState()->setValue(std::forward<TArg>(args)...);
+        FutureState<T>::release(std::exchange(state, nullptr));
+    }
+
+    /// @brief store an exception and wake up the waiting thread
+    void setException(std::exception_ptr exception)
+    {
+        getState()->setException(std::move(exception));
+        FutureState<T>::release(std::exchange(state, nullptr));
+    }
+
+    /// @brief call a callable object and store it's result or the exception it threw
+    template<typename TCallable>
+    void setResultOf(TCallable& callable) noexcept
+    {
+        try
+        {
+            if constexpr (std::is_void<T>::value)
+            {
+                callable();
+                setValue();
+            }
+            else
+            {
+                setValue(callable());
+            }
+        }
+        catch (...)
+        {
+            if (state)
+            {
+                setException(std::current_exception());
+            }
+        }
+    }
+
+private:
+    inline FutureState<T>* getState() const
+    {
+        if (!state)
+        {
+            throw std::runtime_error("Promise already satisfied");
+        }
+        return state;
+    }
+
+    inline void abandon() noexcept
+    {
+        if (state)
+        {
+            state->setException(std::make_exception_ptr(std::runtime_error("Promise destroyed without a result")));
+            FutureState<T>::release(std::exchange(state, nullptr));
+        }
+    }
+
+    FutureState<T>* state { nullptr };
+    bool isFutureRetrieved { false };
+};
+
+}
+
+#endif /* Future_hpp */
@@ -0,0 +1,374 @@
+//
+//  Message.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef Message_hpp
+#define Message_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gusc::Threads
+{
+
+/// @brief type-erased callable object with inline (small buffer) storage
+/// @note callables that don't fit in the inline storage (or can throw on move) are stored on the heap
+class Message
+{
+public:
+    /// @brief size of the inline storage in bytes (Message itself takes 128 bytes)
+    static constexpr std::size_t InlineSize { 112 };
+
+    /// @brief check if a callable type will be stored inline without heap allocation
+    template<typename TCallable>
+    static constexpr bool isInline() noexcept
+    {
+        return sizeof(TCallable) <= InlineSize
+            && alignof(TCallable) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible<TCallable>::value;
+    }
+
+    Message() = default;
+    template<typename TCallable, typename = std::enable_if_t<!std::is_same<std::decay_t<TCallable>, Message>::value>>
+    explicit Message(TCallable&& initCallable)
+    {
+        emplace(std::forward<TCallable>(initCallable));
+    }
+    Message(const Message&) = delete;
+    Message& operator=(const Message&) = delete;
+    Message(Message&& other) noexcept
+    {
+        moveFrom(other);
+    }
+    Message& operator=(Message&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+    ~Message()
+    {
+        reset();
+    }
+
+    /// @brief store a new callable object, destroying the previous one
+    /// @note a Message can only be emplaced as an rvalue (it's moved from, not copied)
+    template<typename TCallable>
+    void emplace(TCallable&& newCallable)
+    {
+        using TStored = std::decay_t<TCallable>;
+        if constexpr (std::is_same<TStored, Message>::value)
+        {
+            static_assert(!std::is_lvalue_reference<TCallable>::value, "Message is move-only, use std::move to emplace it");
+            // Already type-erased, just take over the callable
+            if (&newCallable != this)
+            {
+                reset();
+                moveFrom(newCallable);
+            }
+        }
+        else if constexpr (isInline<TStored>())
+        {
+            reset();
+            new (&storage) TStored(std::forward<TCallable>(newCallable));
+            operations = &InlineOperations<TStored>::table;
+        }
+        else
+        {
+            reset();
+            new (&storage) TStored*(new TStored(std::forward<TCallable>(newCallable)));
+            operations = &HeapOperations<TStored>::table;
+        }
+    }
+
+    /// @brief destroy the stored callable object
+    inline void reset() noexcept
+    {
+        if (operations)
+        {
+            operations->destroy(&storage);
+            operations = nullptr;
+        }
+    }
+
+    /// @brief call the stored callable object
+    inline void operator()()
+    {
+        operations->call(&storage);
+    }
+
+    inline explicit operator bool() const noexcept
+    {
+        return operations != nullptr;
+    }
+
+private:
+    struct Operations
+    {
+        void (*call)(void*);
+        void (*relocate)(void* from, void* to) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<typename TCallable>
+    struct InlineOperations
+    {
+        static void call(void* data)
+        {
+            (*static_cast<TCallable*>(data))();
+        }
+        static void relocate(void* from, void* to) noexcept
+        {
+            auto* source = static_cast<TCallable*>(from);
+            new (to) TCallable(std::move(*source));
+            source->~TCallable();
+        }
+        static void destroy(void* data) noexcept
+        {
+            static_cast<TCallable*>(data)->~TCallable();
+        }
+        static constexpr Operations table { &call, &relocate, &destroy };
+    };
+
+    template<typename TCallable>
+    struct HeapOperations
+    {
+        static void call(void* data)
+        {
+            (**static_cast<TCallable**>(data))();
+        }
+        static void relocate(void* from, void* to) noexcept
+        {
+            new (to) TCallable*(*static_cast<TCallable**>(from));
+        }
+        static void destroy(void* data) noexcept
+        {
+            delete *static_cast<TCallable**>(data);
+        }
+        static constexpr Operations table { &call, &relocate, &destroy };
+    };
+
+    inline void moveFrom(Message& other) noexcept
+    {
+        if (other.operations)
+        {
+            other.operations->relocate(&other.storage, &storage);
+            operations = other.operations;
+            other.operations = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage[InlineSize];
+    const Operations* operations { nullptr };
+};
+
+/// @brief message queue node - a message with an intrusive link to the next node
+struct MessageNode
+{
+    std::atomic<MessageNode*> next { nullptr };
+    Message message;
+};
+
+/// @brief process-wide recycler of message nodes, so that sending a message does not allocate in a steady state
+/// @note every thread keeps a small private cache, surplus nodes are handed over to other threads in batches
+/// @note nodes acquired or released while thread and static destructors run (after the pool is gone) are allocated and deleted directly
+class MessageNodePool
+{
+public:
+    /// @brief get a free node (allocates a new one only if no recycled nodes are available)
+    static MessageNode* acquire()
+    {
+        LocalCache* const cache = getLocalCache();
+        if (!cache)
+        {
+            return new MessageNode();
+        }
+        if (cache->released)
+        {
+            MessageNode* const node = cache->released;
+            cache->released = node->next.load(std::memory_order_relaxed);
+            if (!cache->released)
+            {
+                cache->releasedTail = nullptr;
+            }
+            --cache->releasedSize;
+            return node;
+        }
+        if (!cache->acquired && !getIsSharedListDestroyed())
+        {
+            // Taking the whole shared list with a single exchange makes popping ABA-safe
+            cache->acquired = getSharedList().head.exchange(nullptr, std::memory_order_acquire);
+            std::size_t acquiredSize { 0 };
+            for (MessageNode* node = cache->acquired; node; node = node->next.load(std::memory_order_relaxed))
+            {
+                ++acquiredSize;
+            }
+            getSharedList().size.fetch_sub(acquiredSize, std::memory_order_relaxed);
+        }
+        if (cache->acquired)
+        {
+            MessageNode* const node = cache->acquired;
+            cache->acquired = node->next.load(std::memory_order_relaxed);
+            return node;
+        }
+        return new MessageNode();
+    }
+
+    /// @brief return a node with an empty message to the pool
+    static void release(MessageNode* node) noexcept
+    {
+        LocalCache* const cache = getLocalCache();
+        if (!cache)
+        {
+            delete node;
+            return;
+        }
+        cache->push(node);
+        if (cache->releasedSize >= MaxLocalNodes)
+        {
+            cache->flush();
+        }
+    }
+
+private:
+    static constexpr std::size_t MaxLocalNodes { 256 };
+    /// @brief nodes kept in the shared list, surplus batches are deleted (the count is approximate, batches are counted after they are taken)
+    static constexpr std::size_t MaxSharedNodes { 16 * MaxLocalNodes };
+
+    struct SharedList
+    {
+        std::atomic<MessageNode*> head { nullptr };
+        std::atomic<std::size_t> size { 0 };
+        ~SharedList()
+        {
+            getIsSharedListDestroyed() = true;
+            deleteNodes(head.exchange(nullptr));
+        }
+    };
+
+    struct LocalCache
+    {
+        // Nodes released on this thread, handed over to the shared list once there are too many
+        MessageNode* released { nullptr };
+        MessageNode* releasedTail { nullptr };
+        std::size_t releasedSize { 0 };
+        // Nodes taken from the shared list
+        MessageNode* acquired { nullptr };
+
+        ~LocalCache()
+        {
+            // Thread locals destroyed after the cache release their nodes directly
+            getIsLocalCacheDestroyed() = true;
+            while (acquired)
+            {
+                MessageNode* const node = acquired;
+                acquired = node->next.load(std::memory_order_relaxed);
+                push(node);
+            }
+            if (released)
+            {
+                flush();
+            }
+        }
+
+        inline void push(MessageNode* node) noexcept
+        {
+            if (!releasedTail)
+            {
+                releasedTail = node;
+            }
+            node->next.store(released, std::memory_order_relaxed);
+            released = node;
+            ++releasedSize;
+        }
+
+        /// @brief hand the whole released chain over to the shared list with a single CAS (or delete it if the shared list is full)
+        inline void flush() noexcept
+        {
+            if (getIsSharedListDestroyed() || getSharedList().size.load(std::memory_order_relaxed) >= MaxSharedNodes)
+            {
+                deleteNodes(released);
+            }
+            else
+            {
+                auto& shared = getSharedList();
+                shared.size.fetch_add(releasedSize, std::memory_order_relaxed);
+                MessageNode* expected = shared.head.load(std::memory_order_relaxed);
+                do
+                {
+                    releasedTail->next.store(expected, std::memory_order_relaxed);
+                }
+                while (!shared.head.compare_exchange_weak(expected, released, std::memory_order_release, std::memory_order_relaxed));
+            }
+            released = nullptr;
+            releasedTail = nullptr;
+            releasedSize = 0;
+        }
+    };
+
+    static inline void deleteNodes(MessageNode* node) noexcept
+    {
+        while (node)
+        {
+            MessageNode* const next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    static SharedList& getSharedList() noexcept
+    {
+        static SharedList list;
+        return list;
+    }
+
+    /// @note trivially destructible flags stay valid while the destructors of other statics and thread locals run
+    static std::atomic<bool>& getIsSharedListDestroyed() noexcept
+    {
+        static std::atomic<bool> isDestroyed { false };
+        return isDestroyed;
+    }
+
+    static bool& getIsLocalCacheDestroyed() noexcept
+    {
+        static thread_local bool isDestroyed { false };
+        return isDestroyed;
+    }
+
+    /// @return the cache of the calling thread or nullptr if it has already been destroyed
+    static LocalCache* getLocalCache() noexcept
+    {
+        if (getIsLocalCacheDestroyed())
+        {
+            return nullptr;
+        }
+        static thread_local LocalCache cache;
+        return &cache;
+    }
+};
+
+/// @brief deleter that destroys the message and returns the node to the pool
+struct MessageNodeDeleter
+{
+    inline void operator()(MessageNode* node) const noexcept
+    {
+        node->message.reset();
+        MessageNodePool::release(node);
+    }
+};
+
+using MessageNodePtr = std::unique_ptr<MessageNode, MessageNodeDeleter>;
+
+}
+
+#endif /* Message_hpp */
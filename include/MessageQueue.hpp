@@ -0,0 +1,364 @@
+//
+//  MessageQueue.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef MessageQueue_hpp
+#define MessageQueue_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace gusc::Threads
+{
+
+/// @brief Intrusive lock-free multi-producer single-consumer queue (Dmitry Vyukov's algorithm)
+/// @note TNode must be default constructible and have a std::atomic<TNode*> next member
+/// @note push() can be called from any thread, pop() must only be called from a single consumer thread
+template<typename TNode>
+class MpscQueue
+{
+public:
+    MpscQueue() = default;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    /// @brief push a node to the back of the queue (wait-free)
+    /// @param node - node to push, the queue does not take ownership of it
+    inline void push(TNode* node) noexcept
+    {
+        push(node, node);
+    }
+
+    /// @brief push a pre-linked chain of nodes to the back of the queue with a single publication (wait-free)
+    /// @param first - first node of the chain
+    /// @param last - last node of the chain (reachable from first through next pointers)
+    inline void push(TNode* first, TNode* last) noexcept
+    {
+        last->next.store(nullptr, std::memory_order_relaxed);
+        TNode* const prev = head.exchange(last, std::memory_order_acq_rel);
+        prev->next.store(first, std::memory_order_release);
+    }
+
+    /// @brief pop a node from the front of the queue
+    /// @return node or nullptr if the queue is empty or a producer has not yet finished linking the next node
+    inline TNode* pop() noexcept
+    {
+        TNode* current = tail;
+        TNode* next = current->next.load(std::memory_order_acquire);
+        if (current == &stub)
+        {
+            if (!next)
+            {
+                return nullptr;
+            }
+            tail = next;
+            current = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            tail = next;
+            return current;
+        }
+        if (current != head.load(std::memory_order_acquire))
+        {
+            // A producer is in the middle of a push
+            return nullptr;
+        }
+        push(&stub);
+        next = current->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            tail = next;
+            return current;
+        }
+        return nullptr;
+    }
+
+    /// @brief check if the queue has no nodes (can be called from any thread, but is only a hint for producers)
+    inline bool isEmpty() const noexcept
+    {
+        const TNode* const current = head.load(std::memory_order_acquire);
+        return current == &stub && !stub.next.load(std::memory_order_acquire);
+    }
+
+private:
+    TNode stub;
+    std::atomic<TNode*> head { &stub };
+    TNode* tail { &stub };
+};
+
+/// @brief Lock-free fixed capacity multi-producer multi-consumer ring buffer (Dmitry Vyukov's algorithm)
+/// @note all the slots are allocated up front and values are moved in and out of them
+/// @note T must be default constructible and move assignable
+/// @note the algorithm needs at least 2 cells to tell a full cell from an empty one, a queue of capacity 1 uses 2 cells and checks the capacity on push
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(std::size_t initCapacity)
+        : capacity(initCapacity)
+        , cellCount(std::max<std::size_t>(initCapacity, 2))
+    {
+        if (!capacity)
+        {
+            throw std::invalid_argument("Queue capacity must be greater than 0");
+        }
+        cells = std::make_unique<Cell[]>(cellCount);
+        for (std::size_t i = 0; i < cellCount; ++i)
+        {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+    BoundedQueue(BoundedQueue&&) = delete;
+    BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+    /// @brief move a value to the back of the queue
+    /// @return false if the queue is full (the value is left untouched)
+    inline bool push(T& value) noexcept
+    {
+        std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell { nullptr };
+        for (;;)
+        {
+            cell = &cells[position % cellCount];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0)
+            {
+                if (capacity < cellCount && position - dequeuePosition.load(std::memory_order_acquire) >= capacity)
+                {
+                    return false;
+                }
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief move a value out of the front of the queue
+    /// @return false if the queue is empty
+    inline bool pop(T& value) noexcept
+    {
+        std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell* cell { nullptr };
+        for (;;)
+        {
+            cell = &cells[position % cellCount];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (difference == 0)
+            {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->sequence.store(position + cellCount, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief check if the queue has no values (a value that is being pushed counts as present)
+    inline bool isEmpty() const noexcept
+    {
+        return enqueuePosition.load(std::memory_order_acquire) == dequeuePosition.load(std::memory_order_acquire);
+    }
+
+    /// @brief check if all the slots are taken (a value that is being popped counts as present)
+    inline bool isFull() const noexcept
+    {
+        // Dequeue position is read first, so it can never be ahead of the enqueue position
+        const std::size_t dequeued = dequeuePosition.load(std::memory_order_acquire);
+        return enqueuePosition.load(std::memory_order_acquire) - dequeued >= capacity;
+    }
+
+    inline std::size_t getCapacity() const noexcept
+    {
+        return capacity;
+    }
+
+private:
+    static constexpr std::size_t CacheLineSize { 64 };
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence { 0 };
+        T value;
+    };
+
+    const std::size_t capacity;
+    const std::size_t cellCount;
+    std::unique_ptr<Cell[]> cells;
+    alignas(CacheLineSize) std::atomic<std::size_t> enqueuePosition { 0 };
+    alignas(CacheLineSize) std::atomic<std::size_t> dequeuePosition { 0 };
+};
+
+/// @brief Lock-free work-stealing deque (Chase-Lev algorithm with C11 memory model fixes by Lê et al.)
+/// @note push() and pop() must only be called from the owner thread, steal() can be called from any thread
+template<typename T>
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(std::size_t initCapacity = 256)
+    {
+        std::size_t capacity { 1 };
+        while (capacity < initCapacity)
+        {
+            capacity <<= 1;
+        }
+        arrays.emplace_back(std::make_unique<Array>(capacity));
+        array.store(arrays.back().get(), std::memory_order_relaxed);
+    }
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    /// @brief push an item to the bottom of the deque (owner only)
+    void push(T* item)
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(a->capacity) - 1)
+        {
+            a = grow(a, b, t);
+        }
+        a->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /// @brief pop the most recently pushed item from the bottom of the deque (owner only)
+    /// @return item or nullptr if the deque is empty
+    T* pop() noexcept
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* const a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t <= b)
+        {
+            T* item = a->get(b);
+            if (t == b)
+            {
+                // Last item - race against thieves
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    /// @brief steal the oldest item from the top of the deque (any thread)
+    /// @return item or nullptr if the deque is empty or another thread won the race for the item
+    T* steal() noexcept
+    {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t < b)
+        {
+            Array* const a = array.load(std::memory_order_acquire);
+            T* const item = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+        return nullptr;
+    }
+
+    /// @brief check if the deque has no items (any thread, only a hint)
+    inline bool isEmpty() const noexcept
+    {
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        return bottom.load(std::memory_order_acquire) <= t;
+    }
+
+private:
+    struct Array
+    {
+        explicit Array(std::size_t initCapacity)
+            : capacity(initCapacity)
+            , mask(initCapacity - 1)
+            , items(std::make_unique<std::atomic<T*>[]>(initCapacity))
+        {}
+        inline T* get(std::int64_t index) const noexcept
+        {
+            return items[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+        inline void put(std::int64_t index, T* item) noexcept
+        {
+            items[static_cast<std::size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+        const std::size_t capacity;
+        const std::size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> items;
+    };
+
+    Array* grow(Array* current, std::int64_t b, std::int64_t t)
+    {
+        auto bigger = std::make_unique<Array>(current->capacity * 2);
+        for (std::int64_t i = t; i < b; ++i)
+        {
+            bigger->put(i, current->get(i));
+        }
+        // Thieves might still be reading the old array, so it's only released together with the deque
+        arrays.emplace_back(std::move(bigger));
+        array.store(arrays.back().get(), std::memory_order_release);
+        return arrays.back().get();
+    }
+
+    static constexpr std::size_t CacheLineSize { 64 };
+
+    alignas(CacheLineSize) std::atomic<std::int64_t> top { 0 };
+    alignas(CacheLineSize) std::atomic<std::int64_t> bottom { 0 };
+    std::atomic<Array*> array { nullptr };
+    std::vector<std::unique_ptr<Array>> arrays;
+};
+
+}
+
+#endif /* MessageQueue_hpp */
@@ -10,84 +10,386 @@
 #define Signal_hpp
 
 #include "Thread.hpp"
+#include "Snapshot.hpp"
+#include "Delegate.hpp"
+#include "SlotMap.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <tuple>
-#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace gusc::Threads
 {
 
+/// @brief how a signal delivers the emission to a listener
+enum class ConnectionType
+{
+    /// @brief call directly if the listener's thread is the emitting thread, queue otherwise
+    Auto,
+    /// @brief always call directly on the emitting thread (the listener must be thread-safe)
+    Direct,
+    /// @brief always queue on the listener's thread, even if it's the emitting thread
+    Queued,
+    /// @brief queue on the listener's thread and wait until it's done (called directly if the listener's thread is the emitting thread)
+    /// @warning emitting deadlocks if the listener's thread is waiting for the emitting thread
+    BlockingQueued,
+    /// @brief queue on the listener's thread keeping at most one pending delivery - emissions overwrite the pending one, so the listener only gets the latest value (called directly if the listener's thread is the emitting thread)
+    Conflated
+};
+
 /// @brief class representing a signal connection and emission object
+/// @note use Signal<> or Signal<void> for signals without arguments
 template<typename ...TArg>
 class Signal
 {
-    /// @brief internal class representing a single message that wraps the signal data and the listener and is dispatched to a listener's thread
-    class SignalMessage
-    {
-    public:
-        SignalMessage(const std::function<void(TArg...)>& initCallback, const TArg&... initData)
-            : callback(initCallback)
-            , data(initData...)
-        {}
-        inline void operator()()
-        {
-            std::apply(callback, data);
-        }
-    private:
-        std::function<void(TArg...)> callback;
-        std::tuple<TArg...> data;
-    };
+    using Callback = Delegate<void(const TArg&...)>;
+    /// @brief signal arguments captured once per emission and shared by all the queued deliveries
+    using Payload = std::shared_ptr<const std::tuple<TArg...>>;
     
-    /// @brief internal class representing a signal connection slot (listener and it's affinity thread)
+    /// @brief internal class representing a signal connection slot (listener and it's affinity thread or thread pool)
+    /// @note slots are shared between the slot map, published snapshots and queued messages, a disconnected slot stays behind as a tombstone until the snapshots referring to it are gone
     class Slot
     {
     public:
         Slot() = delete;
-        Slot(Thread* initHostThread, void* initCallbackPtr, const std::function<void(TArg...)>& initCallback)
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+        Slot(Executor* initHostThread, void* initCallbackPtr, const Callback& initCallback, ConnectionType initType, Priority initPriority)
             : hostThread(initHostThread)
             , callbackPtr(initCallbackPtr)
             , callback(initCallback)
+            , type(initType)
+            , priority(initPriority)
         {}
         
-        inline void setConnectionId(size_t newConnectionId) noexcept
+        inline Executor* getHostThread() const noexcept
+        {
+            return hostThread;
+        }
+        
+        inline ConnectionType getType() const noexcept
         {
-            connectionId = newConnectionId;
+            return type;
         }
         
-        inline size_t getConnectionId() const noexcept
+        inline Priority getPriority() const noexcept
         {
-            return connectionId;
+            return priority;
         }
         
-        inline bool operator==(const Slot& other) const noexcept
+        /// @return function or member function pointer the slot was connected with or nullptr for function objects
+        inline void* getCallbackPtr() const noexcept
         {
-            return callbackPtr && hostThread == other.hostThread && callbackPtr != other.callbackPtr;
+            return callbackPtr;
         }
         
+        /// @brief call the listener unless it has been disconnected
         inline void call(const TArg&... args) const
         {
-            if (!hostThread)
+            if (getIsConnected())
             {
-                throw std::runtime_error("Host thread is null");
+                const CallScope scope(this);
+                // Checked again after the call is counted, so that waitForCalls() either sees the call or the call sees the disconnect
+                if (isConnected.load(std::memory_order_seq_cst))
+                {
+                    callback(args...);
+                }
             }
-            if (*hostThread == std::this_thread::get_id())
+        }
+        
+        inline bool getIsConnected() const noexcept
+        {
+            return isConnected.load(std::memory_order_acquire);
+        }
+        
+        /// @brief turn the slot into a tombstone
+        inline void disconnect() noexcept
+        {
+            isConnected.store(false, std::memory_order_seq_cst);
+        }
+        
+        /// @brief wait until the calls that are running on other threads have returned (the slot must be disconnected)
+        /// @note calls the calling thread itself is in the middle of are not waited for
+        inline void waitForCalls() const noexcept
+        {
+            std::size_t ownCalls { 0 };
+            for (const CallScope* scope = CallScope::getTop(); scope; scope = scope->getPrevious())
             {
-                callback(args...);
+                if (scope->getSlot() == this)
+                {
+                    ++ownCalls;
+                }
             }
-            else
+            while (activeCalls.load(std::memory_order_seq_cst) > ownCalls)
             {
-                hostThread->send(SignalMessage{callback, args...});
+                std::this_thread::yield();
             }
         }
         
+        /// @brief replace the pending payload of a conflated connection
+        /// @return false if a delivery is already pending (and will pick up the new payload)
+        inline bool setPending(const Payload& payload)
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            const bool hadPending = static_cast<bool>(pending);
+            pending = payload;
+            return !hadPending;
+        }
+        
+        /// @brief take the pending payload of a conflated connection
+        inline Payload takePending()
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            return std::move(pending);
+        }
+        
+        /// @brief drop the pending payload of a conflated connection, so that the next emission queues a new delivery
+        inline void discardPending() noexcept
+        {
+            Payload discarded;
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            discarded = std::move(pending);
+        }
+        
     private:
-        Thread* hostThread { nullptr };
+        /// @brief counts a running call of the slot and keeps a per-thread stack of them
+        class CallScope
+        {
+        public:
+            explicit CallScope(const Slot* initSlot) noexcept
+                : slot(initSlot)
+                , previous(getTop())
+            {
+                slot->activeCalls.fetch_add(1, std::memory_order_seq_cst);
+                getTop() = this;
+            }
+            CallScope(const CallScope&) = delete;
+            CallScope& operator=(const CallScope&) = delete;
+            ~CallScope()
+            {
+                getTop() = previous;
+                slot->activeCalls.fetch_sub(1, std::memory_order_release);
+            }
+            inline const Slot* getSlot() const noexcept
+            {
+                return slot;
+            }
+            inline const CallScope* getPrevious() const noexcept
+            {
+                return previous;
+            }
+            static inline const CallScope*& getTop() noexcept
+            {
+                static thread_local const CallScope* top { nullptr };
+                return top;
+            }
+        private:
+            const Slot* slot { nullptr };
+            const CallScope* previous { nullptr };
+        };
+        
+        Executor* hostThread { nullptr };
         void* callbackPtr { nullptr };
-        std::function<void(TArg...)> callback;
-        size_t connectionId { 0 };
+        Callback callback;
+        ConnectionType type { ConnectionType::Auto };
+        Priority priority { Priority::Normal };
+        std::atomic<bool> isConnected { true };
+        mutable std::atomic<std::size_t> activeCalls { 0 };
+        std::mutex pendingMutex;
+        Payload pending;
 
     };
     
+    using SlotPtr = std::shared_ptr<Slot>;
+    
+    /// @brief slots of a single target thread with the same connection type and priority (or a single slot of a concurrent executor)
+    /// @note the target's slots are linked in connection order starting from firstSlot
+    struct Target
+    {
+        Executor* hostThread { nullptr };
+        ConnectionType type { ConnectionType::Auto };
+        Priority priority { Priority::Normal };
+        std::size_t firstSlot { 0 };
+    };
+    
+    /// @brief append-only slot and target storage shared by consecutive snapshots
+    /// @note a snapshot only sees the slots and targets that were appended before it was published, so connect appends past them instead of copying
+    struct ConnectionStore
+    {
+        static constexpr std::size_t NoSlot { std::numeric_limits<std::size_t>::max() };
+        
+        explicit ConnectionStore(std::size_t initCapacity)
+            : capacity(initCapacity)
+            , slots(new SlotPtr[initCapacity])
+            , nextSlots(new std::atomic<std::size_t>[initCapacity])
+            , targets(new Target[initCapacity])
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                nextSlots[i].store(NoSlot, std::memory_order_relaxed);
+            }
+        }
+        
+        const std::size_t capacity;
+        std::unique_ptr<SlotPtr[]> slots;
+        /// @brief next slot of the same target - set once, when the next slot is appended (snapshots that don't see that slot stop before it)
+        std::unique_ptr<std::atomic<std::size_t>[]> nextSlots;
+        std::unique_ptr<Target[]> targets;
+    };
+    
+    /// @brief immutable snapshot of the connected slots, grouped by their target threads
+    struct Connections
+    {
+        Connections() = default;
+        Connections(const std::shared_ptr<const ConnectionStore>& initStore, std::size_t initSlotCount, std::size_t initTargetCount) noexcept
+            : store(initStore)
+            , slotCount(initSlotCount)
+            , targetCount(initTargetCount)
+        {}
+        
+        inline const Target* begin() const noexcept
+        {
+            return store ? store->targets.get() : nullptr;
+        }
+        
+        inline const Target* end() const noexcept
+        {
+            return store ? store->targets.get() + targetCount : nullptr;
+        }
+        
+        /// @brief call a function with every slot of the target in connection order
+        template<typename TFunction>
+        inline void forEachSlot(const Target& target, const TFunction& function) const
+        {
+            for (std::size_t index = target.firstSlot; index < slotCount; index = store->nextSlots[index].load(std::memory_order_acquire))
+            {
+                function(store->slots[index]);
+            }
+        }
+        
+        inline void call(const Target& target, const TArg&... args) const
+        {
+            forEachSlot(target, [&args...](const SlotPtr& slot){
+                slot->call(args...);
+            });
+        }
+        
+        std::shared_ptr<const ConnectionStore> store;
+        std::size_t slotCount { 0 };
+        std::size_t targetCount { 0 };
+    };
+    using ConnectionsReference = typename Snapshot<Connections>::Reference;
+    /// @brief completion flag the emitting thread waits on for blocking queued deliveries
+    struct Completion
+    {
+        inline void notify() noexcept
+        {
+            // Notified under the lock - the waiter destroys the completion as soon as it sees the flag
+            std::lock_guard<std::mutex> lock(mutex);
+            isDone = true;
+            condition.notify_one();
+        }
+        inline void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this](){
+                return isDone;
+            });
+        }
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool isDone { false };
+    };
+    /// @brief notifies the completion when the message is done or destroyed without being processed
+    struct CompletionNotifier
+    {
+        inline void operator()(Completion* completion) const noexcept
+        {
+            completion->notify();
+        }
+    };
+    
+    /// @brief internal class representing a single message that is dispatched to a target thread and calls all of it's slots
+    /// @note the message only refers to the slots and the shared payload, slots that are disconnected before the message is processed are skipped
+    class SignalMessage
+    {
+    public:
+        SignalMessage(const ConnectionsReference& initConnections, const Target& initTarget, const Payload& initPayload) noexcept
+            : connections(initConnections)
+            , target(&initTarget)
+            , payload(initPayload)
+        {}
+        inline void operator()()
+        {
+            std::apply([this](const TArg&... args){
+                connections->call(*target, args...);
+            }, *payload);
+        }
+    private:
+        ConnectionsReference connections;
+        const Target* target { nullptr };
+        Payload payload;
+    };
+    
+    /// @brief discards the pending payload when a conflated delivery is destroyed without being processed
+    struct PendingDiscarder
+    {
+        inline void operator()(Slot* slot) const noexcept
+        {
+            slot->discardPending();
+        }
+    };
+    
+    /// @brief internal class representing the single pending delivery of a conflated connection
+    /// @note the payload is taken when the message is processed, so it's always the latest emission
+    /// @note if the message is dropped (by a bounded queue, a drain timeout, a stopped thread or a failed post) the pending payload is discarded, so the next emission queues a new delivery
+    class ConflatedSignalMessage
+    {
+    public:
+        explicit ConflatedSignalMessage(const SlotPtr& initSlot) noexcept
+            : slot(initSlot)
+            , pendingGuard(initSlot.get())
+        {}
+        inline void operator()()
+        {
+            pendingGuard.release();
+            const auto payload = slot->takePending();
+            std::apply([this](const TArg&... args){
+                slot->call(args...);
+            }, *payload);
+        }
+    private:
+        SlotPtr slot;
+        std::unique_ptr<Slot, PendingDiscarder> pendingGuard;
+    };
+    
+    /// @brief internal class representing a message the emitting thread waits for
+    class BlockingSignalMessage
+    {
+    public:
+        BlockingSignalMessage(SignalMessage&& initMessage, Completion& initCompletion) noexcept
+            : message(std::move(initMessage))
+            , completion(&initCompletion)
+        {}
+        inline void operator()()
+        {
+            message();
+            completion.reset();
+        }
+    private:
+        SignalMessage message;
+        std::unique_ptr<Completion, CompletionNotifier> completion;
+    };
+    
 public:
     Signal() = default;
     Signal(const Signal<TArg...>&) = delete;
@@ -97,279 +399,370 @@ public:
     ~Signal() = default;
     
     /// @brief connect a listener callback to this signal
-    /// @param thread - listener's thread of affinity
+    /// @param thread - listener's thread of affinity (a Thread, or a ThreadPool to run the listener on any idle worker - listeners and emissions then run in parallel without any ordering)
     /// @param callback - listener's callback that will be called when signal is emitted
+    /// @param type - how the emission is delivered to the listener
+    /// @param priority - priority lane of the queued deliveries (ignored by executors without priority lanes)
     /// @return connection ID for disconnecting the slot later or 0 if failed to insert the slot
-    inline size_t connect(Thread* thread, const std::function<void(const TArg&...)>& callback) noexcept
+    inline size_t connect(Executor* thread, const Callback& callback, ConnectionType type = ConnectionType::Auto, Priority priority = Priority::Normal) noexcept
     {
-        typedef void(fnType)(const TArg&...);
-        fnType* const* fnPointer = callback.template target<fnType*>();
-        return connect({thread, fnPointer ? reinterpret_cast<void*>(*fnPointer) : nullptr, callback});
+        return connect(thread, nullptr, callback, type, priority);
     }
-
-    /// @brief connect a listener callback to this signal
-    /// @param thread - listener's thread of affinity
-    /// @param callback - listener's callback that will be called when signal is emitted
+    
+    /// @brief connect a listener function to this signal
+    /// @param thread - listener's thread of affinity (a Thread, or a ThreadPool to run the listener on any idle worker)
+    /// @param callback - listener's function that will be called when signal is emitted
+    /// @param type - how the emission is delivered to the listener
+    /// @param priority - priority lane of the queued deliveries
     /// @return connection ID for disconnecting the slot later or 0 if failed to insert the slot
-    template<typename TClass>
-    inline size_t connect(TClass* thread, void(TClass::* callback)(const TArg&...)) noexcept
+    template<typename ...TParam>
+    inline size_t connect(Executor* thread, void(*callback)(TParam...), ConnectionType type = ConnectionType::Auto, Priority priority = Priority::Normal) noexcept
     {
-        return connect(Slot{thread, reinterpret_cast<void*&>(callback), [thread, callback](const TArg&... args){(thread->*callback)(args...);}});
+        return connect(thread, reinterpret_cast<void*>(callback), Callback(callback), type, priority);
     }
 
     /// @brief connect a listener callback to this signal
     /// @param thread - listener's thread of affinity
     /// @param callback - listener's callback that will be called when signal is emitted
+    /// @param type - how the emission is delivered to the listener
+    /// @param priority - priority lane of the queued deliveries
     /// @return connection ID for disconnecting the slot later or 0 if failed to insert the slot
-    template<typename TClass>
-    inline size_t connect(TClass* thread, void(TClass::* callback)(TArg...)) noexcept
+    template<typename TClass, typename ...TParam>
+    inline size_t connect(TClass* thread, void(TClass::* callback)(TParam...), ConnectionType type = ConnectionType::Auto, Priority priority = Priority::Normal) noexcept
     {
-        return connect(Slot{thread, reinterpret_cast<void*&>(callback), [thread, callback](const TArg&... args){(thread->*callback)(args...);}});
+        return connect(thread, reinterpret_cast<void*&>(callback), Callback(thread, callback), type, priority);
     }
     
-    /// @brief disconnect a listener callback from this signal
-    /// @param thread - listener's thread of affinity
-    /// @param callback - listener's callback that will be called when signal is emitted
-    /// @return false if listener was not connected
-    inline bool disconnect(Thread* thread, const std::function<void(const TArg&...)>& callback) noexcept
+    /// @brief function objects can't be disconnected by value - they can only be disconnected using their connection ID
+    /// @note a compile error, so that callers that used to rely on it don't silently keep their listeners connected
+    template<typename TDeferred = void>
+    inline bool disconnect(Executor*, const Callback&) noexcept
     {
-        typedef void(fnType)(const TArg&...);
-        fnType* const* fnPointer = callback.template target<fnType*>();
-        return disconnect({thread, fnPointer ? reinterpret_cast<void*>(*fnPointer) : nullptr, callback});
+        static_assert(!std::is_same<TDeferred, TDeferred>::value, "Function objects can only be disconnected using the connection ID returned from connect()");
+        return false;
     }
     
-    /// @brief disconnect a listener callback from this signal
+    /// @brief disconnect a listener function from this signal
     /// @param thread - listener's thread of affinity
-    /// @param callback - listener's callback that will be called when signal is emitted
+    /// @param callback - listener's function that will be called when signal is emitted
     /// @return false if listener was not connected
-    template<typename TClass>
-    inline bool disconnect(TClass* thread, void(TClass::* callback)(const TArg&...)) noexcept
+    template<typename ...TParam>
+    inline bool disconnect(Executor* thread, void(*callback)(TParam...)) noexcept
     {
-        return disconnect(Slot{thread, reinterpret_cast<void*&>(callback), [thread, callback](const TArg&... args){(thread->*callback)(args...);}});
+        return disconnect(SlotName{thread, reinterpret_cast<void*>(callback)});
     }
-
+    
     /// @brief disconnect a listener callback from this signal
     /// @param thread - listener's thread of affinity
     /// @param callback - listener's callback that will be called when signal is emitted
     /// @return false if listener was not connected
-    template<typename TClass>
-    inline bool disconnect(TClass* thread, void(TClass::* callback)(TArg...)) noexcept
+    template<typename TClass, typename ...TParam>
+    inline bool disconnect(TClass* thread, void(TClass::* callback)(TParam...)) noexcept
     {
-        return disconnect(Slot{thread, reinterpret_cast<void*&>(callback), [thread, callback](const TArg&... args){(thread->*callback)(args...);}});
+        return disconnect(SlotName{thread, reinterpret_cast<void*&>(callback)});
     }
     
     /// @brief disconnect a listener callback from this signal using it's connection ID
+    /// @note the listener is not called by emissions or deliveries that start after this, but a call that is already running on another thread (a direct call from another emitting thread, or a queued one on the listener's thread) may still be in progress when this returns - use disconnectAndWait() before destroying what the listener refers to
     /// @param connectionId - a connection ID assigned and returned from connect() call
     /// @return false if no listener with this connection ID was found
     inline bool disconnect(const size_t connectionId) noexcept
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        const auto it = std::find_if(slots.begin(), slots.end(), [&connectionId](const Slot& s){
-            return s.getConnectionId() == connectionId;
-        });
-        if (it != slots.end())
+        return static_cast<bool>(take(connectionId));
+    }
+    
+    /// @brief disconnect a listener callback and wait until it's calls that are running on other threads have returned
+    /// @note once this returns the listener is never called again - call it before destroying what the listener refers to (e.g. from the destructor of an object the listener captured)
+    /// @note can be called from within the listener itself (that call is not waited for), but it deadlocks if a running call of the listener waits for the calling thread
+    /// @param connectionId - a connection ID assigned and returned from connect() call
+    /// @return false if no listener with this connection ID was found
+    inline bool disconnectAndWait(const size_t connectionId) noexcept
+    {
+        const SlotPtr slot = take(connectionId);
+        if (!slot)
         {
-            slots.erase(it);
-            return true;
+            return false;
         }
-        return false;
+        // Waited for outside the connect mutex, so that the running calls can connect and disconnect listeners
+        slot->waitForCalls();
+        return true;
     }
     
     /// @brief emit the signal to all of it's listeneres
+    /// @note emitting never locks, it only loads the published snapshot - listeners connected during the emission will be called from the next emission on
+    /// @note listeners disconnected during the emission (even by themselves) are not called anymore
+    /// @note listeners are called in connection order per target thread, each target thread receives a single message (per connection type)
     /// @param data - signal arguments
     inline void emit(const TArg&... data) noexcept
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        for (const auto& l : slots)
-        {
-            l.call(data...);
-        }
+        dispatch(data...);
     }
     
-private:
-    std::vector<Slot> slots;
-    size_t uniqueIdCounter { 0 };
-    std::mutex emitMutex;
-    
-    inline size_t connect(const Slot& slot) noexcept
+    /// @brief emit the signal with temporary arguments to all of it's listeneres
+    /// @note arguments are moved (not copied) into the block shared by listeners on other threads
+    /// @param data - signal arguments
+    template<bool HasArguments = (sizeof...(TArg) > 0), typename = std::enable_if_t<HasArguments>>
+    inline void emit(TArg&&... data) noexcept
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        const auto it = std::find(slots.begin(), slots.end(), slot);
-        if (it == slots.end())
-        {
-            auto& s = slots.emplace_back(slot);
-            ++uniqueIdCounter;
-            s.setConnectionId(uniqueIdCounter);
-            return uniqueIdCounter;
-        }
-        else
-        {
-            return it->getConnectionId();
-        }
-        return 0;
+        dispatch(std::move(data)...);
     }
     
-    inline bool disconnect(const Slot& slot) noexcept
+private:
+    /// @brief key of slots connected with a function or member function pointer (used to prevent duplicates and to disconnect them)
+    struct SlotName
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        const auto it = std::find(slots.begin(), slots.end(), slot);
-        if (it != slots.end())
+        Executor* hostThread { nullptr };
+        void* callbackPtr { nullptr };
+        inline bool operator==(const SlotName& other) const noexcept
         {
-            const auto slotIndex = std::distance(slots.begin(), it);
-            slots.erase(it);
-            return true;
+            return hostThread == other.hostThread && callbackPtr == other.callbackPtr;
         }
-        return false;
-    }
-
-};
-
-/// @brief template specialization for void arguments - unfortunatelly vararg templates can't handle that
-template<>
-class Signal<void>
-{
-    class Slot
+    };
+    struct SlotNameHash
     {
-    public:
-        Slot() = delete;
-        Slot(Thread* initHostThread, void* initCallbackPtr, const std::function<void(void)>& initCallback)
-            : hostThread(initHostThread)
-            , callbackPtr(initCallbackPtr)
-            , callback(initCallback)
-        {}
-        
-        inline void setConnectionId(size_t newConnectionId) noexcept
+        inline std::size_t operator()(const SlotName& name) const noexcept
         {
-            connectionId = newConnectionId;
+            const std::hash<const void*> hash;
+            return hash(name.hostThread) ^ (hash(name.callbackPtr) * 31);
         }
-        
-        inline size_t getConnectionId() const noexcept
+    };
+    
+    /// @brief key of the target a slot is grouped into
+    struct TargetKey
+    {
+        Executor* hostThread { nullptr };
+        ConnectionType type { ConnectionType::Auto };
+        Priority priority { Priority::Normal };
+        inline bool operator==(const TargetKey& other) const noexcept
         {
-            return connectionId;
+            return hostThread == other.hostThread && type == other.type && priority == other.priority;
         }
-        
-        bool operator==(const Slot& other)
+    };
+    struct TargetKeyHash
+    {
+        inline std::size_t operator()(const TargetKey& key) const noexcept
         {
-            return callbackPtr && hostThread == other.hostThread && callbackPtr == other.callbackPtr;
+            const std::hash<const void*> hash;
+            return hash(key.hostThread) ^ ((static_cast<std::size_t>(key.type) << 4 | static_cast<std::size_t>(key.priority)) * 31);
         }
-        
-        void call() const
+    };
+    
+    static constexpr std::size_t MinStoreCapacity { 8 };
+    
+    Snapshot<Connections> connections;
+    SlotMap<SlotPtr> slotMap;
+    std::unordered_map<SlotName, size_t, SlotNameHash> namedSlots;
+    // Writer side of the connection store (guarded by connectMutex)
+    std::shared_ptr<ConnectionStore> store;
+    std::size_t slotCount { 0 };
+    std::size_t targetCount { 0 };
+    /// @brief last slot of every target, where the next slot of the target is linked
+    std::vector<std::size_t> targetTails;
+    std::unordered_map<TargetKey, std::size_t, TargetKeyHash> targetIndices;
+    /// @brief number of slots disconnected since the store was compacted
+    std::size_t tombstoneCount { 0 };
+    std::mutex connectMutex;
+    
+    template<typename ...TValue>
+    inline void dispatch(TValue&&... data)
+    {
+        const auto current = connections.load();
+        Payload payload;
+        for (const auto& target : *current)
         {
-            if (*hostThread == std::this_thread::get_id())
+            if (isDirect(target))
             {
-                callback();
+                if (payload)
+                {
+                    // Arguments might have been moved into the payload already
+                    std::apply([&current, &target](const TArg&... args){
+                        current->call(target, args...);
+                    }, *payload);
+                }
+                else
+                {
+                    current->call(target, data...);
+                }
             }
             else
             {
-                hostThread->send(callback);
+                if (!payload)
+                {
+                    // Copied (or moved) only once, no matter how many threads the signal is delivered to
+                    payload = std::make_shared<const std::tuple<TArg...>>(std::forward<TValue>(data)...);
+                }
+                if (target.type == ConnectionType::Conflated)
+                {
+                    // A message per connection is only queued if there is none pending already
+                    current->forEachSlot(target, [&target, &payload](const SlotPtr& slot){
+                        if (slot->getIsConnected() && slot->setPending(payload))
+                        {
+                            // If posting fails the message is destroyed unprocessed, which rolls the pending payload back
+                            target.hostThread->post(Message(ConflatedSignalMessage{slot}), target.priority);
+                        }
+                    });
+                }
+                else if (target.type == ConnectionType::BlockingQueued)
+                {
+                    Completion completion;
+                    target.hostThread->post(Message(BlockingSignalMessage{SignalMessage{current, target, payload}, completion}), target.priority);
+                    completion.wait();
+                }
+                else
+                {
+                    // A single message per target thread, no matter how many slots it has
+                    target.hostThread->post(Message(SignalMessage{current, target, payload}), target.priority);
+                }
             }
         }
-        
-    private:
-        Thread* hostThread { nullptr };
-        void* callbackPtr { nullptr };
-        std::function<void(void)> callback;
-        size_t connectionId { 0 };
-
-    };
-
-    
-public:
-    Signal() = default;
-    Signal(const Signal<void>&) = delete;
-    Signal& operator=(const Signal<void>&) = delete;
-    Signal(Signal<void>&& other) = delete;
-    Signal& operator=(Signal<void>&& other) = delete;
-    ~Signal() = default;
-    
-    inline bool connect(Thread* thread, const std::function<void(void)>& callback) noexcept
-    {
-        typedef void(fnType)(void);
-        fnType* const* fnPointer = callback.target<fnType*>();
-        return connect({thread, fnPointer ? reinterpret_cast<void*>(*fnPointer) : nullptr, callback});
     }
     
-    template<typename TClass>
-    inline bool connect(TClass* thread, void(TClass::* callback)(void)) noexcept
+    /// @brief check if the target's listeners are called on the emitting thread
+    static inline bool isDirect(const Target& target) noexcept
     {
-        return connect(Slot{thread, reinterpret_cast<void*&>(callback), [thread, callback](){(thread->*callback)();}});
+        switch (target.type)
+        {
+            case ConnectionType::Direct:
+                return true;
+            case ConnectionType::Queued:
+                return false;
+            default:
+                return target.hostThread->isCurrent();
+        }
     }
     
-    inline bool disconnect(Thread* thread, const std::function<void(void)>& callback) noexcept
+    /// @brief publish the slots appended so far (connectMutex must be locked)
+    /// @note the snapshot only refers to the shared store, so publishing is O(1) and emitting stays a single snapshot load
+    inline void publish()
     {
-        typedef void(fnType)(void);
-        fnType* const* fnPointer = callback.target<fnType*>();
-        return disconnect({thread, fnPointer ? reinterpret_cast<void*>(*fnPointer) : nullptr, callback});
+        connections.store(std::shared_ptr<const ConnectionStore>(store), slotCount, targetCount);
     }
     
-    template<typename TClass>
-    inline bool disconnect(TClass* thread, void(TClass::* callback)(void)) noexcept
+    /// @brief append a slot to the store and link it to it's target (connectMutex must be locked, the store must have room)
+    inline void append(const SlotPtr& slot)
     {
-        return disconnect(Slot{thread, reinterpret_cast<void*&>(callback), [thread, callback](){(thread->*callback)();}});
+        const std::size_t index = slotCount++;
+        store->slots[index] = slot;
+        const TargetKey key{slot->getHostThread(), slot->getType(), slot->getPriority()};
+        // Slots on a concurrent executor (a thread pool) get a message each, so that they can run in parallel
+        const bool isConcurrent = key.hostThread->getIsConcurrent();
+        if (!isConcurrent)
+        {
+            const auto it = targetIndices.find(key);
+            if (it != targetIndices.end())
+            {
+                store->nextSlots[targetTails[it->second]].store(index, std::memory_order_release);
+                targetTails[it->second] = index;
+                return;
+            }
+            targetIndices.emplace(key, targetCount);
+        }
+        store->targets[targetCount++] = Target{key.hostThread, key.type, key.priority, index};
+        targetTails.push_back(index);
     }
-
-    inline bool disconnect(const size_t connectionId) noexcept
+    
+    /// @brief move the connected slots into a new store in connection order, dropping the tombstones (connectMutex must be locked)
+    /// @note published snapshots keep the previous store alive for as long as they are referenced
+    inline void rebuild(std::size_t capacity)
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        const auto it = std::find_if(slots.begin(), slots.end(), [&connectionId](const Slot& s){
-            return s.getConnectionId() == connectionId;
-        });
-        if (it != slots.end())
+        const auto previous = std::exchange(store, std::make_shared<ConnectionStore>(capacity));
+        const std::size_t previousCount = std::exchange(slotCount, 0);
+        targetCount = 0;
+        targetTails.clear();
+        targetIndices.clear();
+        tombstoneCount = 0;
+        for (std::size_t i = 0; previous && i < previousCount; ++i)
         {
-            slots.erase(it);
-            return true;
+            if (previous->slots[i]->getIsConnected())
+            {
+                append(previous->slots[i]);
+            }
         }
-        return false;
     }
     
-    inline void emit() noexcept
+    inline size_t connect(Executor* thread, void* callbackPtr, const Callback& callback, ConnectionType type, Priority priority) noexcept
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        for (auto& l : slots)
+        if (!thread)
+        {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(connectMutex);
+        const SlotName name{thread, callbackPtr};
+        if (callbackPtr)
+        {
+            const auto it = namedSlots.find(name);
+            if (it != namedSlots.end())
+            {
+                return it->second;
+            }
+        }
+        const auto connectionId = static_cast<size_t>(slotMap.insert(std::make_shared<Slot>(thread, callbackPtr, callback, type, priority)));
+        if (callbackPtr)
+        {
+            namedSlots.emplace(name, connectionId);
+        }
+        if (!store || slotCount == store->capacity)
         {
-            l.call();
+            // Doubling the live slots keeps connect amortized O(1)
+            rebuild(std::max(MinStoreCapacity, slotMap.getSize() * 2));
         }
+        append(*slotMap.find(connectionId));
+        publish();
+        return connectionId;
     }
     
-private:
-    std::vector<Slot> slots;
-    size_t uniqueIdCounter { 0 };
-    std::map<size_t, typename std::vector<Slot>::size_type> indexMap;
-    std::mutex emitMutex;
-    
-    inline bool connect(const Slot& slot) noexcept
+    /// @brief disconnect a listener by it's connection ID
+    /// @return the disconnected slot or nullptr if no listener with this connection ID was found
+    inline SlotPtr take(const size_t connectionId) noexcept
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        const auto it = std::find(slots.begin(), slots.end(), slot);
-        if (it == slots.end())
+        std::lock_guard<std::mutex> lock(connectMutex);
+        const SlotPtr* const found = slotMap.find(connectionId);
+        if (!found)
         {
-            auto& s = slots.emplace_back(slot);
-            ++uniqueIdCounter;
-            s.setConnectionId(uniqueIdCounter);
-            return uniqueIdCounter;
+            return nullptr;
         }
-        else
+        SlotPtr slot = *found;
+        if (slot->getCallbackPtr())
         {
-            return it->getConnectionId();
+            namedSlots.erase({slot->getHostThread(), slot->getCallbackPtr()});
         }
-        return 0;
+        remove(connectionId);
+        return slot;
     }
     
-    inline bool disconnect(const Slot& slot) noexcept
+    inline bool disconnect(const SlotName& name) noexcept
     {
-        std::lock_guard<std::mutex> lock(emitMutex);
-        const auto it = std::find(slots.begin(), slots.end(), slot);
-        if (it != slots.end())
+        std::lock_guard<std::mutex> lock(connectMutex);
+        const auto it = namedSlots.find(name);
+        if (it == namedSlots.end())
         {
-            const auto slotIndex = std::distance(slots.begin(), it);
-            slots.erase(it);
-            return true;
+            return false;
+        }
+        remove(it->second);
+        namedSlots.erase(it);
+        return true;
+    }
+    
+    /// @brief turn the slot into a tombstone and remove it from the slot map (connectMutex must be locked)
+    /// @note tombstones are skipped while emitting, they are only compacted once they outnumber the connected slots (amortized O(1))
+    inline void remove(size_t connectionId) noexcept
+    {
+        (*slotMap.find(connectionId))->disconnect();
+        slotMap.erase(connectionId);
+        if (++tombstoneCount > slotMap.getSize())
+        {
+            rebuild(std::max(MinStoreCapacity, slotMap.getSize() * 2));
+            publish();
         }
-        return false;
     }
 
 };
 
+/// @brief signal without arguments
+template<>
+class Signal<void> : public Signal<>
+{};
+
 }
     
 #endif /* Signal_hpp */
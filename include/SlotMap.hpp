@@ -0,0 +1,162 @@
+//
+//  SlotMap.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef SlotMap_hpp
+#define SlotMap_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace gusc::Threads
+{
+
+/// @brief Generational slot map - O(1) insertion, erasure and lookup with stable keys and dense storage in insertion order
+/// @note erased values leave a hole in the dense storage, holes are compacted once they make up half of it (amortized O(1))
+/// @note keys of erased values are never reused, 0 is never a valid key
+template<typename T>
+class SlotMap
+{
+public:
+    using Key = std::uint64_t;
+
+    /// @brief insert a value at the back of the dense storage
+    /// @return key for looking up or erasing the value later
+    Key insert(T value)
+    {
+        std::uint32_t slot { 0 };
+        if (freeSlots.empty())
+        {
+            slot = static_cast<std::uint32_t>(entries.size());
+            entries.emplace_back();
+        }
+        else
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        auto& entry = entries[slot];
+        const Key key = makeKey(entry.generation, slot);
+        dense.push_back({key, std::move(value)});
+        entry.index = dense.size() - 1;
+        return key;
+    }
+
+    /// @brief erase a value
+    /// @return false if no value with this key is present
+    bool erase(Key key)
+    {
+        Entry* const entry = getEntry(key);
+        if (!entry)
+        {
+            return false;
+        }
+        dense[entry->index].value.reset();
+        ++holeCount;
+        // Invalidate the key, generation 0 is skipped so that keys are never 0
+        if (++entry->generation == 0)
+        {
+            entry->generation = 1;
+        }
+        freeSlots.push_back(getSlot(key));
+        if (holeCount * 2 > dense.size())
+        {
+            compact();
+        }
+        return true;
+    }
+
+    /// @return value or nullptr if no value with this key is present
+    T* find(Key key) noexcept
+    {
+        Entry* const entry = getEntry(key);
+        return entry ? &*dense[entry->index].value : nullptr;
+    }
+
+    /// @brief call a function with every key and value in insertion order
+    template<typename TFunction>
+    void forEach(TFunction&& function) const
+    {
+        for (const auto& item : dense)
+        {
+            if (item.value)
+            {
+                function(item.key, *item.value);
+            }
+        }
+    }
+
+    inline std::size_t getSize() const noexcept
+    {
+        return dense.size() - holeCount;
+    }
+
+private:
+    struct Entry
+    {
+        std::uint32_t generation { 1 };
+        std::size_t index { 0 };
+    };
+
+    struct Item
+    {
+        Key key;
+        std::optional<T> value;
+    };
+
+    static inline Key makeKey(std::uint32_t generation, std::uint32_t slot) noexcept
+    {
+        return (static_cast<Key>(generation) << 32) | slot;
+    }
+
+    static inline std::uint32_t getSlot(Key key) noexcept
+    {
+        return static_cast<std::uint32_t>(key);
+    }
+
+    inline Entry* getEntry(Key key) noexcept
+    {
+        const auto slot = getSlot(key);
+        if (slot >= entries.size() || makeKey(entries[slot].generation, slot) != key)
+        {
+            return nullptr;
+        }
+        return &entries[slot];
+    }
+
+    /// @brief remove the holes keeping the insertion order
+    void compact()
+    {
+        std::size_t next { 0 };
+        for (auto& item : dense)
+        {
+            if (item.value)
+            {
+                if (&dense[next] != &item)
+                {
+                    dense[next].key = item.key;
+                    dense[next].value = std::move(item.value);
+                }
+                entries[getSlot(item.key)].index = next;
+                ++next;
+            }
+        }
+        dense.erase(dense.begin() + static_cast<std::ptrdiff_t>(next), dense.end());
+        holeCount = 0;
+    }
+
+    std::vector<Entry> entries;
+    std::vector<std::uint32_t> freeSlots;
+    std::vector<Item> dense;
+    std::size_t holeCount { 0 };
+};
+
+}
+
+#endif /* SlotMap_hpp */
@@ -0,0 +1,180 @@
+//
+//  Snapshot.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef Snapshot_hpp
+#define Snapshot_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+namespace gusc::Threads
+{
+
+/// @brief Read-copy-update holder of an immutable value
+/// @note readers never lock or wait, writers publish a new copy and only wait for readers that are in the middle of taking a reference
+/// @note writers must be serialized by the caller
+template<typename T>
+class Snapshot
+{
+    struct Node
+    {
+        template<typename ...TArg>
+        explicit Node(TArg&&... args)
+            : value(std::forward<TArg>(args)...)
+        {}
+        const T value;
+        std::atomic<std::size_t> referenceCount { 1 };
+    };
+
+public:
+    /// @brief shared reference to a published value, keeps the value alive even after a newer one is published
+    class Reference
+    {
+    public:
+        Reference() = default;
+        Reference(const Reference& other) noexcept
+            : node(other.node)
+        {
+            acquire();
+        }
+        Reference& operator=(const Reference& other) noexcept
+        {
+            if (node != other.node)
+            {
+                release();
+                node = other.node;
+                acquire();
+            }
+            return *this;
+        }
+        Reference(Reference&& other) noexcept
+            : node(std::exchange(other.node, nullptr))
+        {}
+        Reference& operator=(Reference&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                node = std::exchange(other.node, nullptr);
+            }
+            return *this;
+        }
+        ~Reference()
+        {
+            release();
+        }
+
+        inline const T& operator*() const noexcept
+        {
+            return node->value;
+        }
+        inline const T* operator->() const noexcept
+        {
+            return &node->value;
+        }
+        inline explicit operator bool() const noexcept
+        {
+            return node != nullptr;
+        }
+
+    private:
+        friend class Snapshot;
+
+        /// @brief adopt a node that was already referenced by the caller
+        explicit Reference(Node* initNode) noexcept
+            : node(initNode)
+        {}
+
+        inline void acquire() noexcept
+        {
+            if (node)
+            {
+                node->referenceCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        inline void release() noexcept
+        {
+            Snapshot::release(std::exchange(node, nullptr));
+        }
+
+        Node* node { nullptr };
+    };
+
+    template<typename ...TArg>
+    explicit Snapshot(TArg&&... args)
+        : current(new Node(std::forward<TArg>(args)...))
+    {}
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot(Snapshot&&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+    ~Snapshot()
+    {
+        release(current.load(std::memory_order_acquire));
+    }
+
+    /// @brief get a reference to the current value (lock-free)
+    Reference load() const noexcept
+    {
+        while (true)
+        {
+            const std::size_t epoch = readerEpoch.load(std::memory_order_seq_cst);
+            auto& count = readerCount[epoch & 1].count;
+            count.fetch_add(1, std::memory_order_seq_cst);
+            // A writer that flipped the epoch before we were counted might have missed us, so count again under the new epoch
+            if (readerEpoch.load(std::memory_order_seq_cst) == epoch)
+            {
+                Node* const node = current.load(std::memory_order_seq_cst);
+                node->referenceCount.fetch_add(1, std::memory_order_relaxed);
+                count.fetch_sub(1, std::memory_order_release);
+                return Reference(node);
+            }
+            count.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /// @brief publish a new value, readers holding the previous one keep it alive until they are done with it
+    template<typename ...TArg>
+    void store(TArg&&... args)
+    {
+        Node* const previous = current.exchange(new Node(std::forward<TArg>(args)...), std::memory_order_seq_cst);
+        // Wait for readers that might have loaded the previous node, but not yet referenced it
+        const std::size_t epoch = readerEpoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+        while (readerCount[epoch].count.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+        release(previous);
+    }
+
+private:
+    static inline void release(Node* node) noexcept
+    {
+        if (node && node->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete node;
+        }
+    }
+
+
+    static constexpr std::size_t CacheLineSize { 64 };
+    /// @brief reader counter of one epoch parity, kept on it's own cache line so that counting readers doesn't evict the read-mostly fields
+    struct alignas(CacheLineSize) ReaderCount
+    {
+        std::atomic<std::size_t> count { 0 };
+    };
+
+    std::atomic<Node*> current;
+    mutable std::atomic<std::size_t> readerEpoch { 0 };
+    mutable ReaderCount readerCount[2];
+};
+
+}
+
+#endif /* Snapshot_hpp */
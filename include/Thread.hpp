@@ -9,35 +9,182 @@
 #ifndef Thread_hpp
 #define Thread_hpp
 
+#include "Future.hpp"
+#include "Message.hpp"
+#include "MessageQueue.hpp"
+#include "TimerWheel.hpp"
+
 #include <thread>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <queue>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace
 {
 constexpr const std::size_t MaxSpinCycles { 1000 };
+/// @brief number of messages a waiting lower priority lane can be passed over before it's served
+constexpr const std::size_t StarvationLimit { 64 };
+/// @brief number of messages the run-loop executes before it checks if it's still running and runs the due timers
+constexpr const std::size_t MaxBatchCount { 64 };
 }
 
 namespace gusc::Threads
 {
 
+/// @brief strategy the run-loop uses when there are no messages to process
+enum class IdleStrategy
+{
+    /// @brief keep polling the queue - lowest latency, but burns a whole core (use on pinned cores only)
+    BusySpin,
+    /// @brief yield for MaxSpinCycles polls, then park until a message arrives (default)
+    SpinThenPark,
+    /// @brief park as soon as the queue is empty - lowest CPU usage, but every wake-up goes through the OS
+    Park
+};
+
+/// @brief what a bounded thread does when a message is sent while its queue is full
+enum class OverflowPolicy
+{
+    /// @brief block the sender until there is space in the queue
+    /// @note the thread's own run-loop never blocks on itself (nobody else could make space) - a send from it to its full queue fails like with the Fail policy
+    Block,
+    /// @brief fail immediately - send() throws and trySend() returns false
+    Fail,
+    /// @brief drop the oldest message in the queue to make space for the new one
+    DropOldest
+};
+
+/// @brief message priority lane of a thread
+enum class Priority
+{
+    /// @brief control messages - served before all the others
+    High,
+    /// @brief regular messages (default)
+    Normal,
+    /// @brief bulk messages - served when there is nothing more important to do
+    Low
+};
+
+/// @brief counters of messages sent with a deadline
+struct DeadlineCounters
+{
+    /// @brief number of deadline messages executed
+    std::uint64_t executedCount { 0 };
+    /// @brief number of deadline messages that finished after their deadline
+    std::uint64_t missedCount { 0 };
+    /// @brief the largest lateness seen (time between the deadline and the end of the message)
+    std::chrono::nanoseconds maxLateness { 0 };
+};
+
+/// @brief Interface of an object that executes messages - a signal slot target
+class Executor
+{
+public:
+    virtual ~Executor() = default;
+    
+    /// @brief check if the calling thread is (one of) the executor's thread(s)
+    virtual bool isCurrent() const noexcept = 0;
+    
+    /// @brief post a type-erased message to be executed by this executor
+    virtual void post(Message&& message) = 0;
+    
+    /// @brief post a type-erased message to a priority lane of this executor
+    /// @note executors without priority lanes ignore the priority
+    virtual void post(Message&& message, Priority priority)
+    {
+        static_cast<void>(priority);
+        post(std::move(message));
+    }
+    
+    /// @brief check if messages posted to this executor can run in parallel (no ordering between them)
+    virtual bool getIsConcurrent() const noexcept
+    {
+        return false;
+    }
+    
+    /// @brief check if the calling thread is executing this executor's messages right now
+    /// @note unlike isCurrent() this is false for a thread that has not been started yet
+    virtual bool getIsExecuting() const noexcept
+    {
+        return isCurrent();
+    }
+    
+    /// @brief execute a callable object on this executor and get it's result back
+    /// @note the callable is executed directly if the calling thread is executing the executor's messages already (no queue hop, and no deadlock when waiting for the result)
+    /// @note invoking on a thread that has not been started queues the callable, it's executed once the thread runs
+    /// @note if the message is destroyed without being executed (the executor stopped) the future throws
+    /// @param callable - any callable object taking no arguments
+    /// @param priority - priority lane of the message (ignored by executors without priority lanes)
+    /// @return future of the callable's return value (or the exception it threw)
+    template<typename TCallable>
+    Future<std::invoke_result_t<std::decay_t<TCallable>&>> invoke(TCallable&& callable, Priority priority = Priority::Normal)
+    {
+        using TResult = std::invoke_result_t<std::decay_t<TCallable>&>;
+        Promise<TResult> promise;
+        auto future = promise.getFuture();
+        if (getIsExecuting())
+        {
+            promise.setResultOf(callable);
+        }
+        else
+        {
+            post(Message([promise = std::move(promise), callable = std::forward<TCallable>(callable)]() mutable {
+                promise.setResultOf(callable);
+            }), priority);
+        }
+        return future;
+    }
+};
+
 /// @brief Class representing a new thread
-class Thread
+class Thread : public Executor
 {
 public:
     Thread() = default;
+    explicit Thread(IdleStrategy initIdleStrategy)
+        : idleStrategy(initIdleStrategy)
+    {}
+    /// @brief create a thread with a fixed capacity message queue
+    /// @param capacity - maximum number of queued messages (the queue is allocated up front)
+    /// @param initOverflowPolicy - what to do when a message is sent while the queue is full
+    /// @param initIdleStrategy - run-loop idle strategy
+    Thread(std::size_t capacity, OverflowPolicy initOverflowPolicy, IdleStrategy initIdleStrategy = IdleStrategy::SpinThenPark)
+        : idleStrategy(initIdleStrategy)
+        , overflowPolicy(initOverflowPolicy)
+        , boundedQueue(std::make_unique<BoundedQueue<Message>>(capacity))
+    {}
     Thread(const Thread&) = delete;
     Thread& operator=(const Thread&) = delete;
     Thread(Thread&&) = delete;
     Thread& operator=(Thread&&) = delete;
-    ~Thread()
+    ~Thread() override
     {
         setIsAcceptingMessages(false);
         setIsRunning(false);
+        unpark();
+        unblockSenders();
         join();
+        // Handles outliving the thread can't reach it anymore
+        timerCancellations->close();
+        // Release messages that were never processed (thread was never started)
+        while (!isQueueEmpty())
+        {
+            discardNext();
+        }
+        while (TimerNode* node = timerQueue.pop())
+        {
+            TimerNode::release(node);
+        }
     }
     
     /// @brief start the thread and it's run-loop
@@ -62,6 +209,8 @@ public:
         {
             setIsAcceptingMessages(false);
             setIsRunning(false);
+            unpark();
+            unblockSenders();
         }
         else
         {
@@ -69,6 +218,14 @@ public:
         }
     }
     
+    /// @brief limit how long the run-loop keeps processing leftover messages after stop()
+    /// @note the timeout counts from the stop() call (including the message that is running at that moment), messages that are still in the queue when it expires are destroyed without being executed
+    /// @param timeout - maximum drain duration, zero (default) means drain all the messages
+    void setDrainTimeout(std::chrono::nanoseconds timeout) noexcept
+    {
+        drainTimeout.store(timeout.count(), std::memory_order_relaxed);
+    }
+    
     /// @brief join the thread and wait unti it's finished
     void join()
     {
@@ -79,21 +236,211 @@ public:
     }
     
     /// @brief send a message that needs to be executed on this thread
+    /// @param newMessage - any callable object that will be executed on this thread (rvalues are moved, so move-only callables are supported)
+    /// @param priority - priority lane of the message (messages are FIFO within a lane)
+    /// @note on a bounded thread the overflow policy applies - the call may block, throw or drop the oldest message, priority is ignored (a full Block queue throws instead of blocking when the thread sends to itself)
+    template<typename TCallable>
+    void send(TCallable&& newMessage, Priority priority = Priority::Normal)
+    {
+        if (getCanSend())
+        {
+            if (boundedQueue)
+            {
+                Message message(std::forward<TCallable>(newMessage));
+                if (!pushBounded(message, true))
+                {
+                    throw std::runtime_error("Thread message queue is full");
+                }
+            }
+            else
+            {
+                MessageNodePtr node(MessageNodePool::acquire());
+                node->message.emplace(std::forward<TCallable>(newMessage));
+                getQueue(priority).push(node.release());
+            }
+            notify();
+        }
+        else
+        {
+            throw std::runtime_error("Thread is not excepting any messages, the thread has been signaled for stopping");
+        }
+    }
+    
+    /// @brief send a message without ever blocking the sender
     /// @param newMessage - any callable object that will be executed on this thread
+    /// @param priority - priority lane of the message
+    /// @return false if the bounded queue is full (and the overflow policy is not DropOldest), the message is discarded
     template<typename TCallable>
-    void send(const TCallable& newMessage)
+    bool trySend(TCallable&& newMessage, Priority priority = Priority::Normal)
+    {
+        if (boundedQueue && getCanSend())
+        {
+            Message message(std::forward<TCallable>(newMessage));
+            if (!pushBounded(message, false))
+            {
+                return false;
+            }
+            notify();
+            return true;
+        }
+        send(std::forward<TCallable>(newMessage), priority);
+        return true;
+    }
+    
+    /// @brief send a range of messages that need to be executed on this thread
+    /// @note all the messages are published at once, so they are executed back to back in the range order
+    /// @param begin - iterator to the first callable object (use std::make_move_iterator to move them)
+    /// @param end - iterator past the last callable object
+    /// @param priority - priority lane of the messages
+    /// @note on a bounded thread messages are pushed one by one according to the overflow policy (the same way send() pushes them)
+    template<typename TIterator>
+    void sendBatch(TIterator begin, TIterator end, Priority priority = Priority::Normal)
     {
-        if (getIsAcceptingMessages())
+        if (boundedQueue)
+        {
+            for (; begin != end; ++begin)
+            {
+                send(*begin, priority);
+            }
+        }
+        else if (getCanSend())
         {
-            std::lock_guard<std::mutex> lock(messageMutex);
-            messageQueue.emplace(std::make_unique<CallableMessage<TCallable>>(newMessage));
+            MessageNode* first { nullptr };
+            MessageNode* last { nullptr };
+            try
+            {
+                for (; begin != end; ++begin)
+                {
+                    MessageNodePtr node(MessageNodePool::acquire());
+                    node->message.emplace(*begin);
+                    if (last)
+                    {
+                        last->next.store(node.get(), std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        first = node.get();
+                    }
+                    last = node.release();
+                }
+            }
+            catch (...)
+            {
+                while (first)
+                {
+                    MessageNodePtr node(first);
+                    first = (first == last) ? nullptr : first->next.load(std::memory_order_relaxed);
+                }
+                throw;
+            }
+            if (first)
+            {
+                getQueue(priority).push(first, last);
+                notify();
+            }
         }
         else
         {
             throw std::runtime_error("Thread is not excepting any messages, the thread has been signaled for stopping");
         }
     }
+    
+    /// @brief send a message that needs to be processed by a deadline
+    /// @note deadline messages are executed earliest deadline first - after the high priority lane, but before the normal and low priority lanes (which are protected from starvation the same way as between the lanes)
+    /// @note deadline messages are protected from starvation too - once they have been passed over StarvationLimit times, they go before the high priority lane
+    /// @note messages that finish after their deadline are still executed, they are counted in getDeadlineCounters()
+    /// @note not supported on bounded threads - the deadline heap would bypass the capacity and the overflow policy of the queue and starve it
+    /// @param deadline - time by which the message should be processed
+    /// @param newMessage - any callable object that will be executed on this thread
+    template<typename TCallable>
+    void sendBefore(std::chrono::steady_clock::time_point deadline, TCallable&& newMessage)
+    {
+        if (boundedQueue)
+        {
+            throw std::runtime_error("Deadline messages are not supported on a bounded thread");
+        }
+        if (!getCanSend())
+        {
+            throw std::runtime_error("Thread is not excepting any messages, the thread has been signaled for stopping");
+        }
+        auto node = std::make_unique<TimerNode>();
+        node->deadline = deadline;
+        node->message.emplace(std::forward<TCallable>(newMessage));
+        deadlineQueue.push(node.release());
+        notify();
+    }
+    
+    /// @brief get the counters of executed deadline messages (can be called from any thread)
+    DeadlineCounters getDeadlineCounters() const noexcept
+    {
+        DeadlineCounters counters;
+        counters.executedCount = deadlineExecutedCount.load(std::memory_order_relaxed);
+        counters.missedCount = deadlineMissedCount.load(std::memory_order_relaxed);
+        counters.maxLateness = std::chrono::nanoseconds(deadlineMaxLateness.load(std::memory_order_relaxed));
+        return counters;
+    }
+    
+    /// @brief send a message that needs to be executed on this thread at a given time
+    /// @param deadline - time when the message is executed (it's never executed earlier, messages that are already due are executed right away)
+    /// @param newMessage - any callable object that will be executed on this thread
+    /// @return handle for cancelling the message (a cancelled message is released right away, not at the deadline)
+    /// @note timers that have not fired when the thread stops are destroyed without being executed
+    /// @note due timers run in between batches of at most MaxBatchCount messages, so a busy thread delays them by one batch at most
+    template<typename TCallable>
+    TimerHandle sendAt(std::chrono::steady_clock::time_point deadline, TCallable&& newMessage)
+    {
+        return sendTimer(deadline, std::chrono::steady_clock::duration::zero(), std::forward<TCallable>(newMessage));
+    }
+    
+    /// @brief send a message that needs to be executed on this thread after a delay
+    /// @param delay - time after which the message is executed
+    /// @param newMessage - any callable object that will be executed on this thread
+    /// @return handle for cancelling the message
+    template<typename TRep, typename TPeriod, typename TCallable>
+    TimerHandle sendAfter(std::chrono::duration<TRep, TPeriod> delay, TCallable&& newMessage)
+    {
+        return sendAt(std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(delay), std::forward<TCallable>(newMessage));
+    }
+    
+    /// @brief send a message that needs to be executed on this thread periodically, until it's cancelled
+    /// @param period - time between executions, the first one is one period from now (deadlines don't drift, periods missed by a busy thread are skipped)
+    /// @param newMessage - any callable object that will be executed on this thread
+    /// @return handle for cancelling the message
+    template<typename TRep, typename TPeriod, typename TCallable>
+    TimerHandle sendEvery(std::chrono::duration<TRep, TPeriod> period, TCallable&& newMessage)
+    {
+        const auto timerPeriod = std::chrono::ceil<std::chrono::steady_clock::duration>(period);
+        if (timerPeriod <= std::chrono::steady_clock::duration::zero())
+        {
+            throw std::runtime_error("Timer period must be positive");
+        }
+        return sendTimer(std::chrono::steady_clock::now() + timerPeriod, timerPeriod, std::forward<TCallable>(newMessage));
+    }
         
+    /// @brief check if the calling thread is this thread (or the thread has not been started yet)
+    bool isCurrent() const noexcept override
+    {
+        return getId() == std::this_thread::get_id();
+    }
+    
+    /// @brief check if the calling thread is running this thread's run-loop
+    bool getIsExecuting() const noexcept override
+    {
+        return getIsRunLoopThread();
+    }
+    
+    /// @brief post a type-erased message to be executed on this thread
+    void post(Message&& message) override
+    {
+        send(std::move(message));
+    }
+    
+    /// @brief post a type-erased message to a priority lane of this thread
+    void post(Message&& message, Priority priority) override
+    {
+        send(std::move(message), priority);
+    }
+    
     inline bool operator==(const Thread& other) const noexcept
     {
         return getId() == other.getId();
@@ -114,141 +461,1166 @@ public:
 protected:
     void runLoop()
     {
+        runLoopThreadId.store(std::this_thread::get_id(), std::memory_order_relaxed);
         while (getIsRunning())
         {
-            std::unique_ptr<Message> next;
-            {
-                std::lock_guard<std::mutex> lock(messageMutex);
-                if (messageQueue.size())
-                {
-                    next = std::move(messageQueue.front());
-                    messageQueue.pop();
-                }
-            }
-            if (next)
+            const bool hasRunMessages = runPending();
+            const bool hasRunTimers = runTimers();
+            if (hasRunMessages || hasRunTimers)
             {
                 missCounter = 0;
-                next->call();
             }
             else
             {
-                if (missCounter < MaxSpinCycles)
-                {
-                    ++missCounter;
-                    std::this_thread::yield();
-                }
-                else
-                {
-                    std::this_thread::sleep_for(std::chrono::nanoseconds(1));
-                }
+                idle();
             }
         }
         runLeftovers();
+        runLoopThreadId.store(std::thread::id(), std::memory_order_relaxed);
     }
     
-    void runLeftovers()
+    /// @brief run a batch of at most MaxBatchCount messages, stopping early if the thread has been stopped
+    /// @note the batch is capped, so that a steady stream of messages can't keep the run-loop from seeing stop() or running timers
+    /// @return false if there were no messages
+    bool runPending()
     {
-        // Process any leftover messages
-        std::lock_guard<std::mutex> lock(messageMutex);
-        while (messageQueue.size())
+        if (!runNext())
         {
-            messageQueue.front()->call();
-            messageQueue.pop();
+            return false;
         }
+        for (std::size_t i = 1; i < MaxBatchCount && getIsRunning() && runNext(); ++i)
+        {}
+        return true;
     }
     
-    inline std::thread::id getId() const noexcept
+    /// @brief run the next message in the queue
+    /// @return false if there were no messages
+    bool runNext()
     {
-        if (thread)
+        // Bounded threads don't accept deadline messages
+        if (boundedQueue)
         {
-            return thread->get_id();
+            Message message;
+            if (!boundedQueue->pop(message))
+            {
+                return false;
+            }
+            notifySenders();
+            message();
+            return true;
         }
-        else
+        collectDeadlines();
+        if (!deadlineMessages.empty() && getIsDeadlineTurn())
         {
-            // We haven't started a thread yet, so we're the same thread
-            return std::this_thread::get_id();
+            runDeadline();
+            return true;
+        }
+        if (MessageNodePtr next = popMessage())
+        {
+            if (!deadlineMessages.empty())
+            {
+                ++deadlineStarvedCount;
+            }
+            next->message();
+            return true;
+        }
+        if (!deadlineMessages.empty())
+        {
+            runDeadline();
+            return true;
         }
+        return false;
     }
     
-    inline bool getIsRunning() const noexcept
+    /// @brief move newly sent deadline messages to the deadline heap
+    inline void collectDeadlines()
     {
-        return isRunning;
+        while (TimerNode* const node = deadlineQueue.pop())
+        {
+            node->sequence = ++deadlineSequence;
+            deadlineMessages.push_back(node);
+            std::push_heap(deadlineMessages.begin(), deadlineMessages.end(), &isLaterDeadline);
+        }
     }
-
-    inline void setIsRunning(bool newIsRunning) noexcept
+    
+    /// @brief check if the deadline heap goes before the message lanes - it has been passed over too many times, or the high priority lane is empty and no lower lane is starving
+    inline bool getIsDeadlineTurn() const noexcept
     {
-        isRunning = newIsRunning;
+        if (deadlineStarvedCount >= StarvationLimit)
+        {
+            return true;
+        }
+        if (!getQueue(Priority::High).isEmpty())
+        {
+            return false;
+        }
+        return std::all_of(starvedCounts.begin(), starvedCounts.end(), [](std::size_t count){
+            return count < StarvationLimit;
+        });
     }
     
-    inline bool getIsAcceptingMessages() const noexcept
+    /// @brief run the message with the earliest deadline and update the counters
+    void runDeadline()
     {
-        return isAcceptingMessages;
+        std::pop_heap(deadlineMessages.begin(), deadlineMessages.end(), &isLaterDeadline);
+        std::unique_ptr<TimerNode> node(deadlineMessages.back());
+        deadlineMessages.pop_back();
+        deadlineStarvedCount = 0;
+        for (const auto lane : { Priority::Normal, Priority::Low })
+        {
+            if (!getQueue(lane).isEmpty())
+            {
+                ++starvedCounts[static_cast<std::size_t>(lane)];
+            }
+        }
+        node->message();
+        const auto lateness = std::chrono::steady_clock::now() - node->deadline;
+        deadlineExecutedCount.store(deadlineExecutedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (lateness > std::chrono::steady_clock::duration::zero())
+        {
+            deadlineMissedCount.store(deadlineMissedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            const auto latenessCount = std::chrono::duration_cast<std::chrono::nanoseconds>(lateness).count();
+            if (latenessCount > deadlineMaxLateness.load(std::memory_order_relaxed))
+            {
+                deadlineMaxLateness.store(latenessCount, std::memory_order_relaxed);
+            }
+        }
     }
-
-    inline void setIsAcceptingMessages(bool newIsAcceptingMessages) noexcept
+    
+    /// @brief heap order of deadline messages - earliest deadline (and first sent) on top
+    static inline bool isLaterDeadline(const TimerNode* a, const TimerNode* b) noexcept
     {
-        isAcceptingMessages = newIsAcceptingMessages;
+        return a->deadline > b->deadline || (a->deadline == b->deadline && a->sequence > b->sequence);
     }
-
-private:
     
-    /// @brief base class for thread message
-    class Message
+    /// @brief move newly sent timers to the timer wheel and run the ones that have expired
+    /// @return false if no timers expired
+    bool runTimers()
     {
-    public:
-        virtual void call() {}
-    };
+        removeCancelledTimers();
+        if (timers.isEmpty() && timerQueue.isEmpty())
+        {
+            return false;
+        }
+        const auto now = TimerWheel::Clock::now();
+        auto& expired = timers.advance(now);
+        while (TimerNode* node = timerQueue.pop())
+        {
+            if (node->isCancelled.load(std::memory_order_acquire))
+            {
+                node->message.reset();
+                TimerNode::release(node);
+            }
+            else
+            {
+                timers.add(node);
+            }
+        }
+        if (expired.empty())
+        {
+            return false;
+        }
+        for (auto& entry : expired)
+        {
+            TimerNode* const node = std::exchange(entry, nullptr);
+            if (!node->isCancelled.load(std::memory_order_acquire))
+            {
+                node->message();
+            }
+            if (node->period != TimerWheel::Clock::duration::zero() && !node->isCancelled.load(std::memory_order_acquire))
+            {
+                node->deadline += node->period;
+                if (node->deadline <= now)
+                {
+                    // The thread was busy - skip the missed periods
+                    node->deadline += node->period * ((now - node->deadline) / node->period + 1);
+                }
+                timers.add(node);
+            }
+            else
+            {
+                // Release the callable right away, the handle only keeps the node
+                node->message.reset();
+                TimerNode::release(node);
+            }
+        }
+        expired.clear();
+        return true;
+    }
     
-    /// @brief templated message to wrap a callable object
-    template<typename TCallable>
-    class CallableMessage : public Message
+    /// @brief remove cancelled timers from the timer wheel and release their callables
+    /// @note timers that are not in the wheel yet (or anymore) are released when the run-loop gets to them
+    void removeCancelledTimers() noexcept
     {
-    public:
-        CallableMessage(const TCallable& initCallableObject)
-            : callableObject(initCallableObject)
-        {}
-        void call() override
+        for (TimerNode* node = timerCancellations->take(); node;)
         {
-            callableObject();
+            TimerNode* const cancelled = std::exchange(node, node->nextCancelled);
+            if (timers.remove(cancelled))
+            {
+                cancelled->message.reset();
+                TimerNode::release(cancelled);
+            }
+            TimerNode::release(cancelled);
         }
-    private:
-        TCallable callableObject;
-    };
+    }
     
-    std::size_t missCounter { 0 };
-    std::atomic<bool> isRunning { false };
-    std::atomic<bool> isAcceptingMessages { true };
-    std::queue<std::unique_ptr<Message>> messageQueue;
-    std::unique_ptr<std::thread> thread;
-    std::mutex messageMutex;
-};
-
-/// @brief Class representing a currently executing thread
-class ThisThread : public Thread
-{
-public:
-    ThisThread()
+    /// @brief destroy the next message in the queue without running it
+    void discardNext()
     {
-        // ThisThread is already running
-        setIsRunning(true);
+        collectDeadlines();
+        if (!deadlineMessages.empty())
+        {
+            std::pop_heap(deadlineMessages.begin(), deadlineMessages.end(), &isLaterDeadline);
+            delete deadlineMessages.back();
+            deadlineMessages.pop_back();
+        }
+        else if (boundedQueue)
+        {
+            Message message;
+            if (boundedQueue->pop(message))
+            {
+                notifySenders();
+            }
+        }
+        else
+        {
+            popMessage();
+        }
     }
     
-    /// @brief start the thread and it's run-loop
-    /// @warning calling this method will efectivelly block current thread
-    void start() override
+    /// @brief wait for new messages according to the idle strategy
+    void idle()
     {
-        runLoop();
+        switch (idleStrategy)
+        {
+            case IdleStrategy::BusySpin:
+                break;
+            case IdleStrategy::SpinThenPark:
+                if (missCounter < MaxSpinCycles)
+                {
+                    ++missCounter;
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    park();
+                }
+                break;
+            case IdleStrategy::Park:
+                park();
+                break;
+        }
     }
-
-    /// @brief signal the thread to stop - this also stops receiving messages
-    /// @warning if a message is sent after calling this method an exception will be thrown
-    void stop() override
+    
+    /// @brief block the run-loop until a message arrives, the next timer is due or the thread is stopped
+    void park()
     {
-        setIsAcceptingMessages(false);
-        setIsRunning(false);
-    }
+        std::unique_lock<std::mutex> lock(parkMutex);
+        isParked.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in notify() - either we see the new message or the producer sees us parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isQueueEmpty() && timerQueue.isEmpty() && timerCancellations->isEmpty() && getIsRunning())
+        {
+            if (timers.isEmpty())
+            {
+                parkCondition.wait(lock);
+            }
+            else
+            {
+                parkCondition.wait_until(lock, timers.getNextDeadline());
+            }
+        }
+        isParked.store(false, std::memory_order_relaxed);
+    }
+    
+    /// @brief wake up the run-loop if it's parked (called after publishing a message)
+    inline void notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isParked.load(std::memory_order_relaxed))
+        {
+            unpark();
+        }
+    }
+    
+    /// @brief unconditionally wake up the run-loop
+    inline void unpark()
+    {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        parkCondition.notify_one();
+    }
+    
+    /// @brief push a message to the bounded queue according to the overflow policy
+    /// @param message - message to push (left untouched if it was not pushed)
+    /// @param canBlock - whether the Block policy is allowed to wait for space (the run-loop never waits for itself)
+    /// @return false if the message was not pushed
+    bool pushBounded(Message& message, bool canBlock)
+    {
+        switch (overflowPolicy)
+        {
+            case OverflowPolicy::Block:
+                if (canBlock && !getIsRunLoopThread())
+                {
+                    while (!boundedQueue->push(message))
+                    {
+                        waitForSpace();
+                    }
+                    return true;
+                }
+                return boundedQueue->push(message);
+            case OverflowPolicy::Fail:
+                return boundedQueue->push(message);
+            case OverflowPolicy::DropOldest:
+                while (!boundedQueue->push(message))
+                {
+                    Message dropped;
+                    boundedQueue->pop(dropped);
+                }
+                return true;
+        }
+        return false;
+    }
+    
+    /// @brief block a sender until the consumer frees a slot in the bounded queue
+    void waitForSpace()
+    {
+        std::unique_lock<std::mutex> lock(spaceMutex);
+        waitingSenders.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in notifySenders() - either we see the free slot or the consumer sees us waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (boundedQueue->isFull())
+        {
+            if (!getIsAcceptingMessages())
+            {
+                waitingSenders.fetch_sub(1, std::memory_order_relaxed);
+                throw std::runtime_error("Thread is not excepting any messages, the thread has been signaled for stopping");
+            }
+            spaceCondition.wait(lock);
+        }
+        waitingSenders.fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    /// @brief wake up blocked senders if there are any (called after freeing a slot)
+    inline void notifySenders()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waitingSenders.load(std::memory_order_relaxed))
+        {
+            unblockSenders();
+        }
+    }
+    
+    /// @brief unconditionally wake up all blocked senders
+    inline void unblockSenders()
+    {
+        std::lock_guard<std::mutex> lock(spaceMutex);
+        spaceCondition.notify_all();
+    }
+    
+    inline bool isQueueEmpty() const noexcept
+    {
+        if (!deadlineMessages.empty() || !deadlineQueue.isEmpty())
+        {
+            return false;
+        }
+        if (boundedQueue)
+        {
+            return boundedQueue->isEmpty();
+        }
+        return std::all_of(messageQueues.begin(), messageQueues.end(), [](const MpscQueue<MessageNode>& queue){
+            return queue.isEmpty();
+        });
+    }
+    
+    void runLeftovers()
+    {
+        // Process any leftover messages, messages sent from the run-loop after stop() are accepted as well
+        const auto timeout = std::chrono::nanoseconds(drainTimeout.load(std::memory_order_relaxed));
+        const auto deadline = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(stopTime.load(std::memory_order_relaxed))) + timeout;
+        while (!isQueueEmpty())
+        {
+            if (timeout.count() && std::chrono::steady_clock::now() >= deadline)
+            {
+                // Out of time - drop whatever is left
+                while (!isQueueEmpty())
+                {
+                    discardNext();
+                }
+                break;
+            }
+            runNext();
+        }
+    }
+    
+    inline std::thread::id getId() const noexcept
+    {
+        if (thread)
+        {
+            return thread->get_id();
+        }
+        else
+        {
+            // We haven't started a thread yet, so we're the same thread
+            return std::this_thread::get_id();
+        }
+    }
+    
+    inline bool getIsRunning() const noexcept
+    {
+        return isRunning;
+    }
+
+    inline void setIsRunning(bool newIsRunning) noexcept
+    {
+        if (!newIsRunning && isRunning)
+        {
+            // The drain timeout counts from the moment the thread is signaled to stop (stored before the flag, so the run-loop sees it)
+            stopTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        }
+        isRunning = newIsRunning;
+    }
+    
+    inline bool getIsAcceptingMessages() const noexcept
+    {
+        return isAcceptingMessages;
+    }
+
+    inline void setIsAcceptingMessages(bool newIsAcceptingMessages) noexcept
+    {
+        isAcceptingMessages = newIsAcceptingMessages;
+    }
+    
+    /// @brief check if the calling thread is running this thread's run-loop (including the drain after stop(), false if the run-loop has not been started)
+    inline bool getIsRunLoopThread() const noexcept
+    {
+        return runLoopThreadId.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+    
+    /// @brief check if the caller is allowed to send messages - either the thread accepts messages or the caller is this thread's run-loop (messages it sends after stop() are drained with the leftovers)
+    inline bool getCanSend() const noexcept
+    {
+        return getIsAcceptingMessages() || getIsRunLoopThread();
+    }
+
+private:
+    
+    IdleStrategy idleStrategy { IdleStrategy::SpinThenPark };
+    OverflowPolicy overflowPolicy { OverflowPolicy::Block };
+    std::size_t missCounter { 0 };
+    std::atomic<bool> isParked { false };
+    std::atomic<bool> isRunning { false };
+    std::atomic<bool> isAcceptingMessages { true };
+    std::atomic<std::thread::id> runLoopThreadId;
+    std::atomic<std::chrono::nanoseconds::rep> drainTimeout { 0 };
+    std::atomic<std::chrono::steady_clock::rep> stopTime { 0 };
+    /// @brief message queue of every priority lane
+    std::array<MpscQueue<MessageNode>, 3> messageQueues;
+    /// @brief how many times a waiting lane has been passed over for a higher priority one
+    std::array<std::size_t, 3> starvedCounts {};
+    std::unique_ptr<std::thread> thread;
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+    std::unique_ptr<BoundedQueue<Message>> boundedQueue;
+    std::atomic<std::size_t> waitingSenders { 0 };
+    std::mutex spaceMutex;
+    std::condition_variable spaceCondition;
+    /// @brief timers sent from any thread, moved to the timer wheel by the run-loop
+    MpscQueue<TimerNode> timerQueue;
+    /// @brief deadline messages sent from any thread, moved to the deadline heap by the run-loop
+    MpscQueue<TimerNode> deadlineQueue;
+    /// @brief binary heap of deadline messages, only accessed by the run-loop
+    std::vector<TimerNode*> deadlineMessages;
+    std::uint64_t deadlineSequence { 0 };
+    /// @brief how many times the deadline heap has been passed over for a lane message
+    std::size_t deadlineStarvedCount { 0 };
+    std::atomic<std::uint64_t> deadlineExecutedCount { 0 };
+    std::atomic<std::uint64_t> deadlineMissedCount { 0 };
+    std::atomic<std::chrono::nanoseconds::rep> deadlineMaxLateness { 0 };
+    /// @brief pending timers, only accessed by the run-loop
+    TimerWheel timers;
+    /// @brief timers cancelled from any thread, removed from the timer wheel by the run-loop
+    std::shared_ptr<TimerCancellations> timerCancellations { std::make_shared<TimerCancellations>(Message([this](){
+        notify();
+    })) };
+    
+    inline MpscQueue<MessageNode>& getQueue(Priority priority) noexcept
+    {
+        return messageQueues[static_cast<std::size_t>(priority)];
+    }
+    
+    inline const MpscQueue<MessageNode>& getQueue(Priority priority) const noexcept
+    {
+        return messageQueues[static_cast<std::size_t>(priority)];
+    }
+    
+    /// @brief pop the next message in strict priority order, except that a lower priority lane that has been passed over StarvationLimit times is served first
+    MessageNodePtr popMessage() noexcept
+    {
+        for (std::size_t lane = messageQueues.size() - 1; lane > 0; --lane)
+        {
+            if (starvedCounts[lane] >= StarvationLimit)
+            {
+                starvedCounts[lane] = 0;
+                if (MessageNode* const node = messageQueues[lane].pop())
+                {
+                    return MessageNodePtr(node);
+                }
+            }
+        }
+        for (std::size_t lane = 0; lane < messageQueues.size(); ++lane)
+        {
+            if (MessageNode* const node = messageQueues[lane].pop())
+            {
+                starvedCounts[lane] = 0;
+                for (std::size_t lower = lane + 1; lower < messageQueues.size(); ++lower)
+                {
+                    if (!messageQueues[lower].isEmpty())
+                    {
+                        ++starvedCounts[lower];
+                    }
+                }
+                return MessageNodePtr(node);
+            }
+        }
+        return MessageNodePtr();
+    }
+    
+    template<typename TCallable>
+    TimerHandle sendTimer(std::chrono::steady_clock::time_point deadline, std::chrono::steady_clock::duration period, TCallable&& newMessage)
+    {
+        if (!getCanSend())
+        {
+            throw std::runtime_error("Thread is not excepting any messages, the thread has been signaled for stopping");
+        }
+        auto node = std::make_unique<TimerNode>();
+        node->deadline = deadline;
+        node->period = period;
+        node->message.emplace(std::forward<TCallable>(newMessage));
+        // One reference for the run-loop and one for the handle
+        node->acquire();
+        TimerHandle handle(node.get(), timerCancellations);
+        timerQueue.push(node.release());
+        notify();
+        return handle;
+    }
+};
+
+/// @brief Class representing a currently executing thread
+class ThisThread : public Thread
+{
+public:
+    ThisThread()
+    {
+        // ThisThread is already running
+        setIsRunning(true);
+    }
+    explicit ThisThread(IdleStrategy initIdleStrategy)
+        : Thread(initIdleStrategy)
+    {
+        // ThisThread is already running
+        setIsRunning(true);
+    }
+    ThisThread(std::size_t capacity, OverflowPolicy initOverflowPolicy, IdleStrategy initIdleStrategy = IdleStrategy::SpinThenPark)
+        : Thread(capacity, initOverflowPolicy, initIdleStrategy)
+    {
+        // ThisThread is already running
+        setIsRunning(true);
+    }
+    
+    /// @brief start the thread and it's run-loop
+    /// @warning calling this method will efectivelly block current thread
+    void start() override
+    {
+        runLoop();
+    }
+
+    /// @brief signal the thread to stop - this also stops receiving messages
+    /// @warning if a message is sent after calling this method an exception will be thrown
+    void stop() override
+    {
+        setIsAcceptingMessages(false);
+        setIsRunning(false);
+        unpark();
+    }
 };
     
+/// @brief Class representing a pool of worker threads with per-worker work-stealing deques
+/// @note messages sent to the pool are executed on any of the workers in no particular order
+class ThreadPool : public Executor
+{
+public:
+    /// @brief create a thread pool
+    /// @param workerCount - number of worker threads (defaults to the number of hardware threads)
+    /// @param initIdleStrategy - idle strategy of every worker's run-loop
+    explicit ThreadPool(std::size_t workerCount = std::thread::hardware_concurrency(), IdleStrategy initIdleStrategy = IdleStrategy::SpinThenPark)
+        : idleStrategy(initIdleStrategy)
+    {
+        workerCount = std::max<std::size_t>(workerCount, 1);
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back(std::make_unique<Worker>());
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+    ~ThreadPool() override
+    {
+        setIsAcceptingMessages(false);
+        setIsRunning(false);
+        unparkAll();
+        join();
+        // Release messages that were never processed (pool was never started)
+        for (auto& worker : workers)
+        {
+            while (!worker->inbox.isEmpty())
+            {
+                MessageNodePtr(worker->inbox.pop());
+            }
+            while (MessageNodePtr(worker->deque.pop()))
+            {}
+        }
+    }
+    
+    /// @brief start all the worker threads
+    void start()
+    {
+        if (!getIsRunning())
+        {
+            setIsRunning(true);
+            isStarted = true;
+            for (std::size_t i = 0; i < workers.size(); ++i)
+            {
+                workers[i]->thread = std::thread(&ThreadPool::runLoop, this, i);
+            }
+        }
+        else
+        {
+            throw std::runtime_error("Thread pool already started");
+        }
+    }
+    
+    /// @brief signal the workers to stop - this also stops receiving messages, queued messages are still processed
+    /// @warning if a message is sent after calling this method an exception will be thrown
+    void stop()
+    {
+        if (isStarted)
+        {
+            setIsAcceptingMessages(false);
+            setIsRunning(false);
+            unparkAll();
+        }
+        else
+        {
+            throw std::runtime_error("Thread pool has not been started");
+        }
+    }
+    
+    /// @brief join all the worker threads and wait until they are finished
+    void join()
+    {
+        for (auto& worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+    }
+    
+    /// @brief send a message that needs to be executed on any of the workers
+    /// @note messages sent from a worker are pushed to its own deque, others are distributed between worker inboxes (idle workers first)
+    /// @param newMessage - any callable object that will be executed on the pool
+    /// @param priority - accepted to keep the signature in line with Thread::send(), the pool has no priority lanes so it's ignored
+    template<typename TCallable>
+    void send(TCallable&& newMessage, Priority priority = Priority::Normal)
+    {
+        static_cast<void>(priority);
+        if (getCanSend())
+        {
+            MessageNodePtr node(MessageNodePool::acquire());
+            node->message.emplace(std::forward<TCallable>(newMessage));
+            if (Worker* const current = getCurrentWorker())
+            {
+                current->deque.push(node.release());
+                wakeIdleWorker(current);
+            }
+            else
+            {
+                Worker& target = pickWorker();
+                target.inbox.push(node.release());
+                notify(target);
+            }
+        }
+        else
+        {
+            throw std::runtime_error("Thread pool is not excepting any messages, the pool has been signaled for stopping");
+        }
+    }
+    
+    /// @brief check if the calling thread is one of this pool's workers
+    bool isCurrent() const noexcept override
+    {
+        return getCurrentWorker() != nullptr;
+    }
+    
+    using Executor::post;
+    
+    /// @brief post a type-erased message to be executed on any of the workers
+    void post(Message&& message) override
+    {
+        send(std::move(message));
+    }
+    
+    /// @brief messages run in parallel on all the workers
+    bool getIsConcurrent() const noexcept override
+    {
+        return true;
+    }
+    
+    inline std::size_t getWorkerCount() const noexcept
+    {
+        return workers.size();
+    }
+    
+private:
+    /// @brief maximum number of inbox messages moved to the stealable deque at once
+    static constexpr std::size_t MaxInboxTransfer { 64 };
+    
+    struct Worker
+    {
+        std::thread thread;
+        WorkStealingDeque<MessageNode> deque;
+        MpscQueue<MessageNode> inbox;
+        std::size_t missCounter { 0 };
+        std::size_t stealCounter { 0 };
+        std::atomic<bool> isParked { false };
+        std::mutex parkMutex;
+        std::condition_variable parkCondition;
+    };
+    
+    struct CurrentWorker
+    {
+        const ThreadPool* pool { nullptr };
+        Worker* worker { nullptr };
+    };
+    
+    IdleStrategy idleStrategy { IdleStrategy::SpinThenPark };
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> nextWorker { 0 };
+    std::atomic<bool> isRunning { false };
+    std::atomic<bool> isAcceptingMessages { true };
+    bool isStarted { false };
+    
+    void runLoop(std::size_t index)
+    {
+        Worker& worker = *workers[index];
+        getCurrentWorkerSlot() = { this, &worker };
+        while (getIsRunning())
+        {
+            if (runNext(worker))
+            {
+                worker.missCounter = 0;
+            }
+            else
+            {
+                idle(worker);
+            }
+        }
+        // Process any leftover messages
+        while (hasWork(worker))
+        {
+            runNext(worker);
+        }
+        getCurrentWorkerSlot() = {};
+    }
+    
+    /// @brief run the next message from own deque, own inbox or another worker's deque
+    /// @return false if there was nothing to run
+    bool runNext(Worker& worker)
+    {
+        MessageNodePtr next(worker.deque.pop());
+        if (!next)
+        {
+            next.reset(takeFromInbox(worker));
+        }
+        if (!next)
+        {
+            next.reset(steal(worker));
+        }
+        if (!next)
+        {
+            return false;
+        }
+        next->message();
+        return true;
+    }
+    
+    /// @brief pop the next message from the inbox and move the rest to the deque, so that idle workers can steal them
+    MessageNode* takeFromInbox(Worker& worker)
+    {
+        MessageNode* const first = worker.inbox.pop();
+        if (first)
+        {
+            std::size_t moved { 0 };
+            while (moved < MaxInboxTransfer)
+            {
+                MessageNode* const node = worker.inbox.pop();
+                if (!node)
+                {
+                    break;
+                }
+                worker.deque.push(node);
+                ++moved;
+            }
+            if (moved)
+            {
+                wakeIdleWorker(&worker);
+            }
+        }
+        return first;
+    }
+    
+    /// @brief steal the oldest message from another worker's deque
+    MessageNode* steal(Worker& thief) noexcept
+    {
+        const std::size_t count = workers.size();
+        const std::size_t first = thief.stealCounter++;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Worker& victim = *workers[(first + i) % count];
+            if (&victim != &thief)
+            {
+                if (MessageNode* const node = victim.deque.steal())
+                {
+                    return node;
+                }
+            }
+        }
+        return nullptr;
+    }
+    
+    /// @brief check if there is anything the worker could run
+    bool hasWork(const Worker& worker) const noexcept
+    {
+        if (!worker.inbox.isEmpty())
+        {
+            return true;
+        }
+        for (const auto& other : workers)
+        {
+            if (!other->deque.isEmpty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /// @brief wait for new messages according to the idle strategy
+    void idle(Worker& worker)
+    {
+        switch (idleStrategy)
+        {
+            case IdleStrategy::BusySpin:
+                break;
+            case IdleStrategy::SpinThenPark:
+                if (worker.missCounter < MaxSpinCycles)
+                {
+                    ++worker.missCounter;
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    park(worker);
+                }
+                break;
+            case IdleStrategy::Park:
+                park(worker);
+                break;
+        }
+    }
+    
+    /// @brief block the worker until it's woken up by a sender or the pool is stopped
+    void park(Worker& worker)
+    {
+        std::unique_lock<std::mutex> lock(worker.parkMutex);
+        worker.isParked.store(true, std::memory_order_relaxed);
+        // Pairs with the fences in notify() and wakeIdleWorker()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!hasWork(worker) && getIsRunning())
+        {
+            worker.parkCondition.wait(lock);
+        }
+        worker.isParked.store(false, std::memory_order_relaxed);
+    }
+    
+    /// @brief wake up the worker if it's parked (called after pushing to its inbox)
+    inline void notify(Worker& worker)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (worker.isParked.load(std::memory_order_relaxed))
+        {
+            unpark(worker);
+        }
+    }
+    
+    /// @brief wake up one parked worker so it can steal (called after pushing to a deque)
+    inline void wakeIdleWorker(const Worker* except)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto& worker : workers)
+        {
+            if (worker.get() != except && worker->isParked.load(std::memory_order_relaxed))
+            {
+                unpark(*worker);
+                return;
+            }
+        }
+    }
+    
+    inline void unpark(Worker& worker)
+    {
+        std::lock_guard<std::mutex> lock(worker.parkMutex);
+        worker.parkCondition.notify_one();
+    }
+    
+    inline void unparkAll()
+    {
+        for (auto& worker : workers)
+        {
+            unpark(*worker);
+        }
+    }
+    
+    /// @brief pick a worker to receive a message from outside of the pool - a parked one if possible, otherwise round-robin
+    Worker& pickWorker() noexcept
+    {
+        const std::size_t count = workers.size();
+        const std::size_t first = nextWorker.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Worker& worker = *workers[(first + i) % count];
+            if (worker.isParked.load(std::memory_order_relaxed))
+            {
+                return worker;
+            }
+        }
+        return *workers[first % count];
+    }
+    
+    inline Worker* getCurrentWorker() const noexcept
+    {
+        const auto& current = getCurrentWorkerSlot();
+        return current.pool == this ? current.worker : nullptr;
+    }
+    
+    static CurrentWorker& getCurrentWorkerSlot() noexcept
+    {
+        static thread_local CurrentWorker current;
+        return current;
+    }
+    
+    inline bool getIsRunning() const noexcept
+    {
+        return isRunning;
+    }
+    
+    inline void setIsRunning(bool newIsRunning) noexcept
+    {
+        isRunning = newIsRunning;
+    }
+    
+    inline void setIsAcceptingMessages(bool newIsAcceptingMessages) noexcept
+    {
+        isAcceptingMessages = newIsAcceptingMessages;
+    }
+    
+    /// @brief check if the caller is allowed to send messages - either the pool accepts messages or the caller is a worker draining leftover messages after stop()
+    inline bool getCanSend() const noexcept
+    {
+        return isAcceptingMessages || isCurrent();
+    }
+};
+
+/// @brief Class representing a serialized execution context multiplexed onto a shared executor (usually a ThreadPool)
+/// @note messages sent to a strand are executed in FIFO order and never concurrently, but not necessarily on the same worker
+/// @warning the strand must outlive all the messages sent to it and the executor must outlive the strand
+class Strand : public Executor
+{
+public:
+    /// @brief create a strand
+    /// @param initExecutor - executor the strand's messages are executed on
+    explicit Strand(Executor& initExecutor)
+        : executor(initExecutor)
+    {}
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+    Strand(Strand&&) = delete;
+    Strand& operator=(Strand&&) = delete;
+    ~Strand() override
+    {
+        // Release messages that were never processed (executor was stopped)
+        while (!messageQueue.isEmpty())
+        {
+            MessageNodePtr(messageQueue.pop());
+        }
+    }
+    
+    /// @brief send a message that needs to be executed on this strand
+    /// @param newMessage - any callable object that will be executed on this strand
+    /// @note throws if the executor refuses to schedule the strand (it has been stopped) - only this message is discarded, messages other senders queued in the meantime are kept and the next send schedules them again
+    template<typename TCallable>
+    void send(TCallable&& newMessage)
+    {
+        MessageNodePtr node(MessageNodePool::acquire());
+        node->message.emplace(std::forward<TCallable>(newMessage));
+        MessageNode* const pushed = node.get();
+        messageQueue.push(node.release());
+        // Schedule a drain if the strand was idle, or if the last one was refused by the executor
+        if (pendingCount.fetch_add(1, std::memory_order_acq_rel) == 0 || isDrainRefused.exchange(false, std::memory_order_acq_rel))
+        {
+            if (const auto error = scheduleDrain())
+            {
+                // No drain is running, so the message can be emptied in place - the drain that gets to it skips it
+                pushed->message.reset();
+                isDrainRefused.store(true, std::memory_order_release);
+                std::rethrow_exception(error);
+            }
+        }
+    }
+    
+    /// @brief check if the calling thread is currently executing this strand's message
+    bool isCurrent() const noexcept override
+    {
+        return getCurrentStrand() == this;
+    }
+    
+    using Executor::post;
+    
+    /// @brief post a type-erased message to be executed on this strand
+    void post(Message&& message) override
+    {
+        send(std::move(message));
+    }
+    
+private:
+    /// @brief maximum number of messages executed in one go before the worker is handed back to the executor
+    static constexpr std::size_t MaxDrainCount { 64 };
+    
+    Executor& executor;
+    MpscQueue<MessageNode> messageQueue;
+    std::atomic<std::size_t> pendingCount { 0 };
+    /// @brief the executor refused the last drain - pending messages wait for the next send to schedule them
+    std::atomic<bool> isDrainRefused { false };
+    
+    /// @brief marks the strand as current on the calling thread for the lifetime of the scope
+    class CurrentScope
+    {
+    public:
+        explicit CurrentScope(const Strand* strand) noexcept
+            : previous(getCurrentStrand())
+        {
+            getCurrentStrand() = strand;
+        }
+        CurrentScope(const CurrentScope&) = delete;
+        CurrentScope& operator=(const CurrentScope&) = delete;
+        ~CurrentScope()
+        {
+            getCurrentStrand() = previous;
+        }
+    private:
+        const Strand* previous { nullptr };
+    };
+    
+    /// @brief post a drain of the pending messages to the executor
+    /// @return the executor's error if it refused the drain (the pending messages are kept)
+    std::exception_ptr scheduleDrain() noexcept
+    {
+        try
+        {
+            executor.post(Message([this](){
+                drain();
+            }));
+            return nullptr;
+        }
+        catch (...)
+        {
+            return std::current_exception();
+        }
+    }
+    
+    /// @brief schedule the rest of the pending messages from within a drain
+    /// @note if the executor refuses, the messages wait for the next send instead of failing on the executor's thread
+    void continueDrain() noexcept
+    {
+        if (scheduleDrain())
+        {
+            isDrainRefused.store(true, std::memory_order_release);
+        }
+    }
+    
+    void drain()
+    {
+        const CurrentScope scope(this);
+        for (std::size_t i = 0; i < MaxDrainCount; ++i)
+        {
+            if (!runNext())
+            {
+                return;
+            }
+        }
+        // There are more messages - continue later, so that other work on the executor is not starved
+        continueDrain();
+    }
+    
+    /// @brief run the next pending message
+    /// @return false if the strand has no more pending messages
+    bool runNext()
+    {
+        MessageNodePtr node(popNext());
+        try
+        {
+            // Messages refused by the executor have been emptied
+            if (node->message)
+            {
+                node->message();
+            }
+        }
+        catch (...)
+        {
+            // The message is done even though it failed - keep the strand going for the ones after it
+            if (pendingCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                continueDrain();
+            }
+            throw;
+        }
+        return pendingCount.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+    
+    /// @brief pop the next message, waiting for a sender that is in the middle of a push
+    /// @note the message must have been counted in pendingCount already
+    MessageNode* popNext() noexcept
+    {
+        MessageNode* node = messageQueue.pop();
+        while (!node)
+        {
+            std::this_thread::yield();
+            node = messageQueue.pop();
+        }
+        return node;
+    }
+    
+    static const Strand*& getCurrentStrand() noexcept
+    {
+        static thread_local const Strand* current { nullptr };
+        return current;
+    }
+};
+
 }
 
 #endif /* Thread_hpp */
@@ -0,0 +1,472 @@
+//
+//  TimerWheel.hpp
+//  Threads
+//
+//  Copyright © 2026 Threads contributors. All rights reserved.
+//
+
+#ifndef TimerWheel_hpp
+#define TimerWheel_hpp
+
+#include "Message.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gusc::Threads
+{
+
+/// @brief a scheduled message - shared between the timer wheel and the timer handles
+/// @note also used for messages sent with a deadline, which are ordered in the thread's deadline heap
+struct TimerNode
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief link used while the node is queued for the run-loop
+    std::atomic<TimerNode*> next { nullptr };
+    /// @brief links used while the node is in a timer wheel slot
+    TimerNode* nextInSlot { nullptr };
+    TimerNode* previousInSlot { nullptr };
+    /// @brief link used while the node is waiting for it's cancellation to be processed
+    TimerNode* nextCancelled { nullptr };
+    /// @brief timer wheel slot the node is in
+    std::uint8_t wheelLevel { 0 };
+    std::uint8_t wheelSlot { 0 };
+    bool isScheduled { false };
+    Clock::time_point deadline;
+    /// @brief repeat period, zero for one-shot timers
+    Clock::duration period { Clock::duration::zero() };
+    /// @brief deadline in timer wheel ticks
+    std::uint64_t expires { 0 };
+    /// @brief scheduling order, used to run timers with equal deadlines in FIFO order
+    std::uint64_t sequence { 0 };
+    Message message;
+    std::atomic<bool> isCancelled { false };
+    std::atomic<std::size_t> referenceCount { 1 };
+
+    inline void acquire() noexcept
+    {
+        referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static inline void release(TimerNode* node) noexcept
+    {
+        if (node && node->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete node;
+        }
+    }
+};
+
+/// @brief cancelled timers waiting for the run-loop to remove them from it's timer wheel
+/// @note shared between the run-loop and the timer handles, so that a handle can be cancelled after the run-loop is gone
+class TimerCancellations
+{
+public:
+    /// @param initWake - callable that wakes up the run-loop
+    explicit TimerCancellations(Message&& initWake) noexcept
+        : wake(std::move(initWake))
+    {}
+    TimerCancellations(const TimerCancellations&) = delete;
+    TimerCancellations& operator=(const TimerCancellations&) = delete;
+    ~TimerCancellations()
+    {
+        close();
+    }
+
+    /// @brief queue a cancelled timer for removal and wake up the run-loop (ignored once the run-loop is closed)
+    void push(TimerNode* node) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isClosed)
+        {
+            return;
+        }
+        node->acquire();
+        node->nextCancelled = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(node->nextCancelled, node, std::memory_order_release, std::memory_order_relaxed))
+        {}
+        wake();
+    }
+
+    /// @brief take all the queued timers, the caller takes over the node references (lock-free, run-loop only)
+    inline TimerNode* take() noexcept
+    {
+        return head.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    inline bool isEmpty() const noexcept
+    {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /// @brief stop accepting cancellations and release the queued ones (called before the run-loop is destroyed)
+    void close() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isClosed = true;
+        for (TimerNode* node = take(); node;)
+        {
+            TimerNode::release(std::exchange(node, node->nextCancelled));
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::atomic<TimerNode*> head { nullptr };
+    Message wake;
+    bool isClosed { false };
+};
+
+/// @brief handle of a scheduled message used to cancel it
+/// @note dropping the handle does not cancel the timer
+class TimerHandle
+{
+public:
+    TimerHandle() = default;
+    /// @brief adopt a node reference
+    /// @param initCancellations - cancellations of the run-loop the timer was sent to (cancelled timers are released right away instead of at their deadline)
+    explicit TimerHandle(TimerNode* initNode, std::shared_ptr<TimerCancellations> initCancellations = nullptr) noexcept
+        : node(initNode)
+        , cancellations(std::move(initCancellations))
+    {}
+    TimerHandle(const TimerHandle& other) noexcept
+        : node(other.node)
+        , cancellations(other.cancellations)
+    {
+        if (node)
+        {
+            node->acquire();
+        }
+    }
+    TimerHandle& operator=(const TimerHandle& other) noexcept
+    {
+        TimerHandle copy(other);
+        std::swap(node, copy.node);
+        std::swap(cancellations, copy.cancellations);
+        return *this;
+    }
+    TimerHandle(TimerHandle&& other) noexcept
+        : node(std::exchange(other.node, nullptr))
+        , cancellations(std::move(other.cancellations))
+    {}
+    TimerHandle& operator=(TimerHandle&& other) noexcept
+    {
+        TimerHandle moved(std::move(other));
+        std::swap(node, moved.node);
+        std::swap(cancellations, moved.cancellations);
+        return *this;
+    }
+    ~TimerHandle()
+    {
+        TimerNode::release(node);
+    }
+
+    /// @brief cancel the timer - it will not fire anymore (a call that is already running is not interrupted)
+    /// @note can be called from any thread, including the timer's own callback to stop a periodic timer
+    /// @note the run-loop is woken up to remove the timer and release it's callable without waiting for the deadline
+    inline void cancel() noexcept
+    {
+        if (node && !node->isCancelled.exchange(true, std::memory_order_acq_rel) && cancellations)
+        {
+            cancellations->push(node);
+        }
+    }
+
+    inline bool getIsCancelled() const noexcept
+    {
+        return node && node->isCancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    TimerNode* node { nullptr };
+    std::shared_ptr<TimerCancellations> cancellations;
+};
+
+/// @brief Hierarchical timer wheel (the layout of William Ahern's timeout.c) - O(1) scheduling, expiry cost proportional to the number of expired timers
+/// @note 6 levels of 64 slots with 1 microsecond ticks cover ~19 hours, timers further out are cascaded down when the top level comes around
+/// @note not thread-safe - the wheel is owned by a single run-loop
+class TimerWheel
+{
+public:
+    using Clock = TimerNode::Clock;
+
+    explicit TimerWheel(Clock::time_point now = Clock::now())
+        : currentTick(toTickFloor(now))
+    {}
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    ~TimerWheel()
+    {
+        for (auto& level : slots)
+        {
+            for (auto* node : level)
+            {
+                while (node)
+                {
+                    TimerNode::release(std::exchange(node, node->nextInSlot));
+                }
+            }
+        }
+        for (auto* node : expired)
+        {
+            TimerNode::release(node);
+        }
+    }
+
+    /// @brief add a timer to the wheel, the wheel takes over the node reference
+    /// @note timers that are already due expire on the next advance()
+    void add(TimerNode* node) noexcept
+    {
+        node->expires = toTickCeil(node->deadline);
+        node->sequence = ++sequenceCounter;
+        ++size;
+        schedule(node);
+    }
+
+    /// @brief remove a timer from the wheel in O(1), the caller takes over the node reference
+    /// @return false if the timer is not in the wheel (it has expired or was never added)
+    bool remove(TimerNode* node) noexcept
+    {
+        if (!node->isScheduled)
+        {
+            return false;
+        }
+        if (node->previousInSlot)
+        {
+            node->previousInSlot->nextInSlot = node->nextInSlot;
+        }
+        else
+        {
+            slots[node->wheelLevel][node->wheelSlot] = node->nextInSlot;
+            if (!node->nextInSlot)
+            {
+                occupied[node->wheelLevel] &= ~(std::uint64_t(1) << node->wheelSlot);
+            }
+        }
+        if (node->nextInSlot)
+        {
+            node->nextInSlot->previousInSlot = node->previousInSlot;
+        }
+        node->nextInSlot = nullptr;
+        node->previousInSlot = nullptr;
+        node->isScheduled = false;
+        --size;
+        return true;
+    }
+
+    /// @brief advance the wheel to the current time
+    /// @return timers that have expired in deadline order, the caller takes over the node references and must clear the list before the next advance
+    std::vector<TimerNode*>& advance(Clock::time_point now)
+    {
+        const std::uint64_t nowTick = toTickFloor(now);
+        if (nowTick <= currentTick)
+        {
+            return expired;
+        }
+        if (!size)
+        {
+            currentTick = nowTick;
+            return expired;
+        }
+        // Collect all the slots that the wheels have passed
+        TimerNode* todo { nullptr };
+        std::uint64_t elapsed = nowTick - currentTick;
+        for (std::size_t level = 0; level < LevelCount; ++level)
+        {
+            const std::size_t shift = level * SlotBits;
+            std::uint64_t passed { 0 };
+            if ((elapsed >> shift) > SlotMask)
+            {
+                passed = ~std::uint64_t(0);
+            }
+            else
+            {
+                const auto levelElapsed = (elapsed >> shift) & SlotMask;
+                const auto oldSlot = (currentTick >> shift) & SlotMask;
+                const auto newSlot = (nowTick >> shift) & SlotMask;
+                const std::uint64_t mask = (std::uint64_t(1) << levelElapsed) - 1;
+                passed = rotateLeft(mask, oldSlot);
+                passed |= rotateRight(rotateLeft(mask, newSlot), levelElapsed);
+                passed |= std::uint64_t(1) << newSlot;
+            }
+            while (passed & occupied[level])
+            {
+                const auto slot = countTrailingZeros(passed & occupied[level]);
+                for (TimerNode* node = std::exchange(slots[level][slot], nullptr); node;)
+                {
+                    TimerNode* const nextNode = node->nextInSlot;
+                    node->isScheduled = false;
+                    node->nextInSlot = todo;
+                    todo = node;
+                    node = nextNode;
+                }
+                occupied[level] &= ~(std::uint64_t(1) << slot);
+            }
+            if (!(passed & 1))
+            {
+                // This level did not wrap around, so the higher ones did not move
+                break;
+            }
+            elapsed = std::max(elapsed, std::uint64_t(SlotCount) << shift);
+        }
+        currentTick = nowTick;
+        // Expire or cascade the collected timers to lower levels
+        while (todo)
+        {
+            TimerNode* const node = std::exchange(todo, todo->nextInSlot);
+            if (node->expires <= currentTick)
+            {
+                node->nextInSlot = nullptr;
+                --size;
+                expired.push_back(node);
+            }
+            else
+            {
+                schedule(node);
+            }
+        }
+        std::sort(expired.begin(), expired.end(), [](const TimerNode* a, const TimerNode* b){
+            return a->expires < b->expires || (a->expires == b->expires && a->sequence < b->sequence);
+        });
+        return expired;
+    }
+
+    /// @brief get the time when the wheel has to be advanced next (a timer expires or has to be cascaded down)
+    /// @note must only be called if the wheel is not empty
+    Clock::time_point getNextDeadline() const noexcept
+    {
+        std::uint64_t timeout = ~std::uint64_t(0);
+        std::uint64_t relativeMask { 0 };
+        for (std::size_t level = 0; level < LevelCount; ++level)
+        {
+            if (occupied[level])
+            {
+                const std::size_t shift = level * SlotBits;
+                const auto slot = (currentTick >> shift) & SlotMask;
+                // Timers on higher levels are at least one rotation in the future (otherwise they would be on a lower level)
+                std::uint64_t levelTimeout = (countTrailingZeros(rotateRight(occupied[level], slot)) + (level ? 1 : 0)) << shift;
+                // Reduce by how much the lower levels have progressed
+                levelTimeout -= relativeMask & currentTick;
+                timeout = std::min(timeout, levelTimeout);
+            }
+            relativeMask = (relativeMask << SlotBits) | SlotMask;
+        }
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(Tick(currentTick + timeout)));
+    }
+
+    inline bool isEmpty() const noexcept
+    {
+        return size == 0;
+    }
+
+    /// @brief number of timers in the wheel
+    inline std::size_t getSize() const noexcept
+    {
+        return size;
+    }
+
+private:
+    using Tick = std::chrono::microseconds;
+
+    static constexpr std::size_t SlotBits { 6 };
+    static constexpr std::size_t SlotCount { 1 << SlotBits };
+    static constexpr std::uint64_t SlotMask { SlotCount - 1 };
+    static constexpr std::size_t LevelCount { 6 };
+
+    static inline std::uint64_t toTickFloor(Clock::time_point time) noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::floor<Tick>(time.time_since_epoch()).count());
+    }
+
+    static inline std::uint64_t toTickCeil(Clock::time_point time) noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::ceil<Tick>(time.time_since_epoch()).count());
+    }
+
+    static inline std::uint64_t rotateLeft(std::uint64_t value, std::uint64_t count) noexcept
+    {
+        count &= 63;
+        return count ? (value << count) | (value >> (64 - count)) : value;
+    }
+
+    static inline std::uint64_t rotateRight(std::uint64_t value, std::uint64_t count) noexcept
+    {
+        count &= 63;
+        return count ? (value >> count) | (value << (64 - count)) : value;
+    }
+
+    /// @note value must not be 0
+    static inline std::size_t countTrailingZeros(std::uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(value));
+#else
+        std::size_t count { 0 };
+        while (!(value & 1))
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    /// @note value must not be 0
+    static inline std::size_t findLastSet(std::uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 64 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+        std::size_t count { 0 };
+        while (value)
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    /// @brief put a timer in the slot of the level it's remaining time belongs to
+    void schedule(TimerNode* node) noexcept
+    {
+        // Timers that are already due go to the next tick
+        const std::uint64_t expires = std::max(node->expires, currentTick + 1);
+        const std::uint64_t remaining = expires - currentTick;
+        const std::size_t level = std::min((findLastSet(remaining) - 1) / SlotBits, LevelCount - 1);
+        const std::size_t slot = ((expires >> (level * SlotBits)) - (level ? 1 : 0)) & SlotMask;
+        node->nextInSlot = slots[level][slot];
+        node->previousInSlot = nullptr;
+        if (node->nextInSlot)
+        {
+            node->nextInSlot->previousInSlot = node;
+        }
+        node->wheelLevel = static_cast<std::uint8_t>(level);
+        node->wheelSlot = static_cast<std::uint8_t>(slot);
+        node->isScheduled = true;
+        slots[level][slot] = node;
+        occupied[level] |= std::uint64_t(1) << slot;
+    }
+
+    std::array<std::array<TimerNode*, SlotCount>, LevelCount> slots {};
+    std::array<std::uint64_t, LevelCount> occupied {};
+    std::uint64_t currentTick { 0 };
+    std::uint64_t sequenceCounter { 0 };
+    std::size_t size { 0 };
+    std::vector<TimerNode*> expired;
+};
+
+}
+
+#endif /* TimerWheel_hpp */